@@ -0,0 +1,200 @@
+#!/bin/sh
+# Builds the fake root filesystem read by make bench through UWUFETCH_ROOT:
+#     bench/fixture.sh <directory>
+# It looks like a desktop with an 8 core cpu, an amd gpu and a few thousand
+# packages, and it is the same on every machine: nothing is copied from the
+# host. The directory is created if needed, its old content is replaced.
+
+[ -n "$1" ] || { echo "usage: $0 <directory>" >&2; exit 1; }
+root=$1
+rm -rf "$root/etc" "$root/proc" "$root/sys" "$root/usr" "$root/var"
+mkdir -p "$root/etc" "$root/proc" "$root/sys/devices/virtual/dmi/id" \
+	"$root/usr/share/hwdata" "$root/var/lib/dpkg" "$root/var/lib/pacman/local" \
+	"$root/bin" || exit 1
+
+cat > "$root/etc/os-release" << 'EOF'
+NAME="Arch Linux"
+PRETTY_NAME="Arch Linux"
+ID=arch
+BUILD_ID=rolling
+ANSI_COLOR="38;2;23;147;209"
+HOME_URL="https://archlinux.org/"
+DOCUMENTATION_URL="https://wiki.archlinux.org/"
+LOGO=archlinux-logo
+EOF
+echo fixture > "$root/etc/hostname"
+
+# 16 threads, every one with the full block of a real cpuinfo
+awk 'BEGIN {
+	for (i = 0; i < 16; i++) {
+		printf "processor\t: %d\nvendor_id\t: AuthenticAMD\n", i
+		printf "cpu family\t: 25\nmodel\t\t: 33\n"
+		printf "model name\t: AMD Ryzen 7 5800X 8-Core Processor\n"
+		printf "stepping\t: 0\nmicrocode\t: 0xa201016\ncpu MHz\t\t: 3800.000\n"
+		printf "cache size\t: 512 KB\nphysical id\t: 0\nsiblings\t: 16\n"
+		printf "core id\t\t: %d\ncpu cores\t: 8\napicid\t\t: %d\n", i % 8, i
+		printf "fpu\t\t: yes\nfpu_exception\t: yes\ncpuid level\t: 16\n"
+		printf "wp\t\t: yes\nflags\t\t: fpu vme de pse tsc msr pae mce cx8 apic"
+		printf " sep mtrr pge mca cmov pat pse36 clflush mmx fxsr sse sse2 ht"
+		printf " syscall nx mmxext fxsr_opt pdpe1gb rdtscp lm constant_tsc"
+		printf " rep_good nopl nonstop_tsc cpuid extd_apicid aperfmperf pni"
+		printf " pclmulqdq monitor ssse3 fma cx16 sse4_1 sse4_2 movbe popcnt"
+		printf " aes xsave avx f16c rdrand lahf_lm cmp_legacy svm extapic"
+		printf " cr8_legacy abm sse4a misalignsse 3dnowprefetch osvw ibs skinit"
+		printf " wdt tce topoext perfctr_core perfctr_nb bpext perfctr_llc"
+		printf " mwaitx cpb cat_l3 cdp_l3 hw_pstate ssbd mba ibrs ibpb stibp"
+		printf " vmmcall fsgsbase bmi1 avx2 smep bmi2 erms invpcid cqm rdt_a"
+		printf " rdseed adx smap clflushopt clwb sha_ni xsaveopt xsavec xgetbv1"
+		printf " xsaves umip pku ospke vaes vpclmulqdq rdpid fsrm\n"
+		printf "bogomips\t: 7600.00\nTLB size\t: 2560 4K pages\n"
+		printf "clflush size\t: 64\ncache_alignment\t: 64\n"
+		printf "address sizes\t: 48 bits physical, 48 bits virtual\n"
+		printf "power management: ts ttp tm hwpstate cpb eff_freq_ro\n\n"
+	}
+}' > "$root/proc/cpuinfo"
+
+# 8 cores with 2 threads each, cpu n and n + 8 are the threads of a core
+cpus="$root/sys/devices/system/cpu"
+mkdir -p "$cpus/cpu0/cpufreq"
+echo 0-15 > "$cpus/online"
+echo 4700000 > "$cpus/cpu0/cpufreq/cpuinfo_max_freq"
+i=0
+while [ $i -lt 16 ]; do
+	mkdir -p "$cpus/cpu$i/topology"
+	echo "$((i % 8)),$((i % 8 + 8))" > "$cpus/cpu$i/topology/core_cpus_list"
+	echo 0-15 > "$cpus/cpu$i/topology/package_cpus_list"
+	i=$((i + 1))
+done
+
+cat > "$root/proc/meminfo" << 'EOF'
+MemTotal:       32791720 kB
+MemFree:        18127064 kB
+MemAvailable:   25420388 kB
+Buffers:          412340 kB
+Cached:          6871204 kB
+SwapCached:            0 kB
+Active:          5633148 kB
+Inactive:        7205072 kB
+Active(anon):    5021840 kB
+Inactive(anon):        0 kB
+Active(file):     611308 kB
+Inactive(file):  7205072 kB
+Unevictable:       84812 kB
+Mlocked:               0 kB
+SwapTotal:       8388604 kB
+SwapFree:        8123900 kB
+Dirty:               912 kB
+Writeback:             0 kB
+AnonPages:       5589036 kB
+Mapped:          1351572 kB
+Shmem:            327420 kB
+KReclaimable:     268512 kB
+Slab:             512396 kB
+SReclaimable:     268512 kB
+SUnreclaim:       243884 kB
+KernelStack:       24320 kB
+PageTables:        61132 kB
+NFS_Unstable:          0 kB
+Bounce:                0 kB
+WritebackTmp:          0 kB
+CommitLimit:    24784464 kB
+Committed_AS:   15728924 kB
+VmallocTotal:   34359738367 kB
+VmallocUsed:      101452 kB
+VmallocChunk:          0 kB
+Percpu:            21504 kB
+HardwareCorrupted:     0 kB
+AnonHugePages:         0 kB
+ShmemHugePages:        0 kB
+ShmemPmdMapped:        0 kB
+FileHugePages:         0 kB
+FilePmdMapped:         0 kB
+HugePages_Total:      16
+HugePages_Free:       12
+HugePages_Rsvd:        0
+HugePages_Surp:        0
+Hugepagesize:       2048 kB
+Hugetlb:           32768 kB
+DirectMap4k:      824524 kB
+DirectMap2M:    12619776 kB
+DirectMap1G:    20971520 kB
+EOF
+
+echo "B550 AORUS ELITE V2" > "$root/sys/devices/virtual/dmi/id/board_name"
+echo "X570 GAMING X" > "$root/sys/devices/virtual/dmi/id/product_name"
+echo "Default string" > "$root/sys/devices/virtual/dmi/id/product_version"
+
+# a host bridge, the gpu with its audio function and an nvme disk
+pci_device() { # address class vendor device
+	dir="$root/sys/bus/pci/devices/$1"
+	mkdir -p "$dir"
+	echo "$2" > "$dir/class"
+	echo "$3" > "$dir/vendor"
+	echo "$4" > "$dir/device"
+}
+pci_device 0000:00:00.0 0x060000 0x1022 0x1480
+pci_device 0000:0a:00.0 0x030000 0x1002 0x73bf
+pci_device 0000:0a:00.1 0x040300 0x1002 0xab28
+pci_device 0000:0b:00.0 0x010802 0x144d 0xa808
+# two monitors, the modes file starts with the preferred mode
+drm_connector() { # name status [modes...]
+	dir="$root/sys/class/drm/card0-$1"
+	mkdir -p "$dir"
+	echo "$2" > "$dir/status"
+	shift 2
+	: > "$dir/modes"
+	for mode in "$@"; do echo "$mode" >> "$dir/modes"; done
+}
+mkdir -p "$root/sys/class/drm/card0" "$root/sys/class/drm/renderD128"
+drm_connector DP-1 connected 2560x1440 1920x1080 1280x720
+drm_connector DP-2 disconnected
+drm_connector HDMI-A-1 connected 1920x1080 1680x1050 1280x1024
+
+# the real names of the devices above among thousands of made up vendors, so
+# the pci.ids index is as big as the real one
+awk 'BEGIN {
+	print "# pci.ids of the uwufetch benchmark fixture"
+	print "1002  Advanced Micro Devices, Inc. [AMD/ATI]"
+	print "\t73bf  Navi 21 [Radeon RX 6800/6800 XT / 6900 XT]"
+	print "\tab28  Navi 21/23 HDMI/DP Audio Controller"
+	print "1022  Advanced Micro Devices, Inc. [AMD]"
+	print "\t1480  Starship/Matisse Root Complex"
+	print "144d  Samsung Electronics Co Ltd"
+	print "\ta808  NVMe SSD Controller SM981/PM981/PM983"
+	for (v = 0; v < 2500; v++) {
+		printf "%04x  Vendor %d Corporation\n", 0x2000 + v, v
+		for (d = 0; d < 8; d++)
+			printf "\t%04x  Device %d of vendor %d [Model %d]\n", d, d, v, d
+	}
+	print "C 03  Display controller"
+}' > "$root/usr/share/hwdata/pci.ids"
+
+# 1800 dpkg and 1200 pacman packages, with entries as long as the real ones
+awk 'BEGIN {
+	for (i = 0; i < 1800; i++) {
+		printf "Package: package-%d\n", i
+		printf "Status: install ok %s\n", i % 50 ? "installed" : "config-files"
+		printf "Priority: optional\nSection: misc\nInstalled-Size: %d\n", i * 7
+		printf "Maintainer: Fixture Maintainers <fixture@example.org>\n"
+		printf "Architecture: amd64\nVersion: 1.%d.0-1\n", i
+		printf "Depends: libc6 (>= 2.34), package-%d (>= 1.0)\n", i / 2
+		printf "Description: benchmark package %d\n", i
+		printf " A package that only exists to make the status file as big\n"
+		printf " as the one of a real desktop installation.\n"
+		if (i % 100 == 0) # a continuation line is not a field
+			printf " Status: install ok installed\n"
+		printf "\n"
+	}
+}' > "$root/var/lib/dpkg/status"
+i=0
+while [ $i -lt 1200 ]; do
+	mkdir "$root/var/lib/pacman/local/package-$i-1.0-1"
+	i=$((i + 1))
+done
+
+# only the commands used in the pipelines of pkgman(), so that the package
+# managers that are run as commands are never found
+for tool in awk grep tail wc; do
+	path=$(command -v $tool) && ln -sf "$path" "$root/bin/$tool"
+done
+exit 0
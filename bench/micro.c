@@ -0,0 +1,105 @@
+/*
+ Times the hot functions of a cached run in isolation: the string rewrites
+(strbuf_replace(), which replaced replace(), and uwu_hw()), read_cache() with
+both cache formats, and print_ascii() and print_info() without the final
+write. The info is collected once from UWUFETCH_ROOT and written to the
+caches in $HOME, so make bench runs it on the fixture. Every function is run
+in batches of at least 20 ms and the best batch is reported.
+*/
+#define main uwufetch_main
+#include "../fetch.c"
+#include "../uwufetch.c"
+#undef main
+
+struct configuration bench_config;
+struct info bench_info;
+char text_cache_file[512], binary_cache_file[512];
+
+double seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// a kernel name rewritten back and forth, so it never grows
+void bench_replace(void) {
+	static char data[256] = "Linux 6.1.0-13-amd64 x86_64 Linux Linux";
+	static struct strbuf buf = {data, 39, sizeof(data)};
+	strbuf_replace(&buf, 0, 5, "Linuwu", 6);
+	strbuf_replace(&buf, 0, 6, "Linux", 5);
+}
+
+void bench_uwu_hw(void) {
+	char gpu[256] = "Advanced Micro Devices, Inc. AMD/ATI Navi 21 Radeon RX "
+					"6800/6800 XT / 6900 XT";
+	uwu_hw(gpu, sizeof(gpu));
+}
+
+// the strings are dropped after every read, like in a new process
+void bench_read_cache(char *cache_file,
+					  int (*reader)(char *cache_file, struct info *user_info)) {
+	if (!reader(cache_file, &bench_info)) {
+		fprintf(stderr, "could not read %s\n", cache_file);
+		exit(1);
+	}
+	bench_info.strings.size = 0;
+}
+
+void bench_read_binary_cache(void) {
+	bench_read_cache(binary_cache_file, read_binary_cache);
+}
+
+void bench_read_text_cache(void) {
+	bench_read_cache(text_cache_file, read_text_cache);
+}
+
+void bench_print_ascii(void) {
+	print_ascii(&bench_info);
+	output->buf.len = 0;
+}
+
+void bench_print_info(void) {
+	print_info(&bench_config, &bench_info);
+	output->buf.len = 0;
+}
+
+void bench(const char *name, void (*function)(void)) {
+	long iterations = 1;
+	double best		= 1e9;
+	for (int batch = 0; batch < 5;) {
+		double start = seconds();
+		for (long i = 0; i < iterations; i++) function();
+		double time = seconds() - start;
+		if (time < 0.02) { // too short to be measured, not counted
+			iterations *= 2;
+			continue;
+		}
+		if (time / iterations < best) best = time / iterations;
+		batch++;
+	}
+	printf("%-22s %10.1f ns\n", name, best * 1e9);
+}
+
+int main(void) {
+	if (!getenv("HOME") || !init_info(&bench_info)) return 1;
+	bench_config	 = parse_config(&bench_info);
+	probe_timeout	 = bench_config.probe_timeout;
+	collect_deadline = monotonic_ms() + bench_config.total_timeout;
+	get_info(&bench_config, &bench_info, enabled_fields(&bench_config));
+	sprintf(text_cache_file, "%s/.cache/uwufetch.cache", getenv("HOME"));
+	sprintf(binary_cache_file, "%s/.cache/uwufetch.bin", getenv("HOME"));
+	write_text_cache(text_cache_file, &bench_info);
+	if (!write_binary_cache(binary_cache_file, &bench_info)) {
+		fprintf(stderr, "could not write %s\n", binary_cache_file);
+		return 1;
+	}
+
+	bench("strbuf_replace", bench_replace);
+	bench("uwu_hw", bench_uwu_hw);
+	bench("read_cache (text)", bench_read_text_cache);
+	bench("read_cache (binary)", bench_read_binary_cache);
+	bench("print_ascii", bench_print_ascii);
+	bench("print_info", bench_print_info);
+	free_info(&bench_info);
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ Times a command like hyperfine does: it is run a few times to warm the caches
+up, then the given number of times with its output thrown away, and the mean,
+standard deviation, range and cpu time of the runs are printed:
+    repeat [-r runs] [-w warmup runs] <name> <command> [arguments...]
+The command is run directly, without a shell, so that only its own time is
+measured. Exits with 1 if any run fails.
+*/
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+double seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+double cpu_seconds(struct timeval time) {
+	return time.tv_sec + time.tv_usec / 1e6;
+}
+
+// returns the exit status of the command, -1 if it could not be started
+int run(char **command) {
+	pid_t pid = fork();
+	if (pid < 0) return -1;
+	if (pid == 0) {
+		int null = open("/dev/null", O_WRONLY);
+		dup2(null, STDOUT_FILENO);
+		dup2(null, STDERR_FILENO);
+		execvp(command[0], command);
+		_exit(127);
+	}
+	int status;
+	if (waitpid(pid, &status, 0) < 0) return -1;
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+int main(int argc, char *argv[]) {
+	int runs = 30, warmup = 3, opt;
+	while ((opt = getopt(argc, argv, "+r:w:")) != -1) {
+		if (opt == 'r')
+			runs = atoi(optarg);
+		else if (opt == 'w')
+			warmup = atoi(optarg);
+		else
+			return 2;
+	}
+	if (argc - optind < 2 || runs < 1) {
+		fprintf(stderr, "usage: %s [-r runs] [-w warmup] <name> <command>...\n",
+				argv[0]);
+		return 2;
+	}
+	char *name = argv[optind], **command = argv + optind + 1;
+
+	for (int i = 0; i < warmup; i++)
+		if (run(command) != 0) {
+			fprintf(stderr, "%s: %s failed\n", name, command[0]);
+			return 1;
+		}
+	double *times = malloc(runs * sizeof(*times)), sum = 0, min = 1e9, max = 0;
+	struct rusage before, after;
+	getrusage(RUSAGE_CHILDREN, &before);
+	for (int i = 0; i < runs; i++) {
+		double start = seconds();
+		if (run(command) != 0) {
+			fprintf(stderr, "%s: %s failed\n", name, command[0]);
+			return 1;
+		}
+		times[i] = seconds() - start;
+		sum += times[i];
+		if (times[i] < min) min = times[i];
+		if (times[i] > max) max = times[i];
+	}
+	getrusage(RUSAGE_CHILDREN, &after);
+	double mean = sum / runs, variance = 0;
+	for (int i = 0; i < runs; i++)
+		variance += (times[i] - mean) * (times[i] - mean);
+	double deviation = runs > 1 ? sqrt(variance / (runs - 1)) : 0;
+	double user = cpu_seconds(after.ru_utime) - cpu_seconds(before.ru_utime),
+		   sys	= cpu_seconds(after.ru_stime) - cpu_seconds(before.ru_stime);
+	printf("%-22s %8.2f ms ± %6.2f  [%7.2f … %7.2f]  user %6.2f, sys %6.2f "
+		   "ms, %d runs\n",
+		   name, mean * 1e3, deviation * 1e3, min * 1e3, max * 1e3,
+		   user * 1e3 / runs, sys * 1e3 / runs, runs);
+	free(times);
+	return 0;
+}
@@ -0,0 +1,54 @@
+#!/bin/sh
+# Times uwufetch on the fixture of bench/fixture.sh, so that the results do
+# not depend on the machine having a gpu, a network or packages installed:
+#     bench/run.sh [runs]
+# The full run and the cached runs are timed by bench/repeat, then the hot
+# functions by bench/micro. Both are built by make bench, which runs this.
+# The probes still run their commands, but PATH only has the few tools the
+# fixture links, so they fail the same way everywhere.
+
+cd "$(dirname "$0")/.." || exit 1
+runs=${1:-30}
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+sh bench/fixture.sh "$tmp/root" || exit 1
+mkdir -p "$tmp/home/.cache" "$tmp/home/.config/uwufetch" "$tmp/runtime"
+printf 'swap=true\nbuff_cache=true\nhugepages=true\n' \
+	> "$tmp/home/.config/uwufetch/config"
+cp uwufetch bench/repeat bench/micro "$tmp/" || exit 1
+
+# the runtime directory is empty, a running daemon is never used
+export UWUFETCH_ROOT="$tmp/root" HOME="$tmp/home" XDG_RUNTIME_DIR="$tmp/runtime"
+export USER=bench SHELL=/bin/sh
+unset UWUFETCH_CACHE_ENABLED DISPLAY WAYLAND_DISPLAY
+fixture() { # runs a command with the PATH of the fixture
+	PATH="$tmp/root/bin" "$@"
+}
+repeat() {
+	fixture "$tmp/repeat" -r "$runs" "$@" || exit 1
+}
+
+# the native package count has to match the one of dpkg itself
+if command -v dpkg-query > /dev/null; then
+	expected=$(dpkg-query --admindir="$tmp/root/var/lib/dpkg" -W \
+		-f '${db:Status-Status}\n' | grep -c '^installed$')
+	counted=$(fixture "$tmp/uwufetch" -o pkgs -F kv |
+		sed -n 's/^pkgman=\([0-9]*\) (apt).*/\1/p')
+	if [ "$counted" != "$expected" ]; then
+		echo "dpkg packages: uwufetch counts $counted, dpkg-query $expected" >&2
+		exit 1
+	fi
+fi
+
+echo "uwufetch on the fixture, $runs runs each:"
+repeat "full run" "$tmp/uwufetch"
+repeat "write cache" "$tmp/uwufetch" -w
+for format in text binary; do
+	fixture "$tmp/uwufetch" -w -f $format > /dev/null
+	UWUFETCH_CACHE_ENABLED=1 repeat "cached run ($format)" \
+		"$tmp/uwufetch" -f $format
+done
+echo
+echo "functions, best batch:"
+fixture "$tmp/micro" || exit 1
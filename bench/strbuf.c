@@ -0,0 +1,135 @@
+/*
+ Checks strbuf_replace() against a naive rewrite on random edits, then runs
+uwu_hw(), uwu_kernel() and the logo expansion on long inputs and times them.
+The buffers are allocated with their exact size, so make asan catches any
+write past them. Results go to stderr, the rendered logos to stdout.
+Build and run with make bench_strbuf or make asan.
+*/
+#define main uwufetch_main
+#include "../fetch.c"
+#include "../uwufetch.c"
+#undef main
+
+double seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// the reference: builds the whole result and cuts it at the capacity
+int naive_replace(char *result, size_t cap, const char *data, size_t start,
+				  size_t len, const char *with, size_t with_len) {
+	size_t data_len = strlen(data);
+	char *full		= malloc(data_len + with_len + 1);
+	if (start > data_len) start = data_len;
+	if (len > data_len - start) len = data_len - start;
+	memcpy(full, data, start);
+	memcpy(full + start, with, with_len);
+	strcpy(full + start + with_len, data + start + len);
+	size_t full_len = strlen(full);
+	int cut			= full_len > cap - 1;
+	if (cut) full_len = cap - 1;
+	memcpy(result, full, full_len);
+	result[full_len] = '\0';
+	free(full);
+	return cut ? -1 : 0;
+}
+
+void random_text(char *text, size_t len, unsigned *seed) {
+	for (size_t i = 0; i < len; i++) text[i] = 'a' + rand_r(seed) % 26;
+	text[len] = '\0';
+}
+
+int check_replace(int iterations) {
+	unsigned seed  = 42;
+	int mismatches = 0;
+	for (int i = 0; i < iterations; i++) {
+		size_t cap = 1 + rand_r(&seed) % 64, with_len = rand_r(&seed) % 80;
+		char *data = malloc(cap), *expected = malloc(cap), with[80];
+		random_text(data, rand_r(&seed) % cap, &seed);
+		random_text(with, with_len, &seed);
+		size_t start = rand_r(&seed) % (cap + 2), len = rand_r(&seed) % 20;
+		int expected_cut =
+			naive_replace(expected, cap, data, start, len, with, with_len);
+		struct strbuf buf = strbuf_wrap(data, cap);
+		int cut			  = strbuf_replace(&buf, start, len, with, with_len);
+		if (cut != expected_cut || buf.len != strlen(expected) ||
+			strcmp(data, expected) != 0) {
+			if (mismatches++ < 10)
+				fprintf(stderr,
+						"mismatch: cap %zu start %zu len %zu with %zu\n"
+						"  expected: \"%s\" (%d)\n       got: \"%s\" (%d)\n",
+						cap, start, len, with_len, expected, expected_cut,
+						data, cut);
+		}
+		free(data);
+		free(expected);
+	}
+	fprintf(stderr, "%d random edits checked, %d mismatches\n", iterations,
+			mismatches);
+	return mismatches;
+}
+
+// repeats words separated by spaces until size - 1 bytes are filled
+void fill_words(char *text, size_t size, const char **words, int count) {
+	text[0]			  = '\0'; // wrapped empty, nothing is read from it
+	struct strbuf buf = strbuf_wrap(text, size);
+	for (int i = 0; strbuf_append(&buf, words[i % count],
+								  strlen(words[i % count])) == 0 &&
+					strbuf_append(&buf, " ", 1) == 0;
+		 i++)
+		;
+}
+
+int main(int argc, char *argv[]) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+	int failed = check_replace(rounds * 50) != 0;
+
+	// the names grow while they are rewritten, so every call cuts them
+	const char *hw_words[] = {"NVIDIA", "Corporation", "GeForce", "cpu",
+							  "Intel(R)", "Graphics", "apple", "gpu"};
+	const char *kernel_words[] = {"linux", "arch", "6.1.0", "debian",
+								  "gentoo", "", "ubuntu", "x86_64"};
+	size_t sizes[] = {16, 256, 4096, 65536};
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		char *text = malloc(sizes[s]), *kernel = malloc(sizes[s]);
+		double start = seconds(), hw_time, kernel_time;
+		for (int r = 0; r < rounds; r++) {
+			fill_words(text, sizes[s], hw_words, 8);
+			uwu_hw(text, sizes[s]);
+		}
+		hw_time = seconds() - start;
+		if (strlen(text) >= sizes[s]) failed = 1;
+		start = seconds();
+		for (int r = 0; r < rounds; r++) {
+			fill_words(text, sizes[s], kernel_words, 8);
+			kernel[0]		  = '\0';
+			struct strbuf buf = strbuf_wrap(kernel, sizes[s]);
+			uwu_kernel(&buf, text);
+		}
+		kernel_time = seconds() - start;
+		if (strlen(kernel) >= sizes[s]) failed = 1;
+		fprintf(stderr, "%6zu bytes: uwu_hw %10.1f ns, uwu_kernel %10.1f ns\n",
+				sizes[s], hw_time * 1e9 / rounds, kernel_time * 1e9 / rounds);
+		free(text);
+		free(kernel);
+	}
+
+	// a logo far bigger than the output buffer, mostly placeholders
+	size_t logo_size = 4 * OUTPUT_SIZE;
+	char *logo		 = malloc(logo_size);
+	logo[0]			 = '\0';
+	struct strbuf buf = strbuf_wrap(logo, logo_size);
+	const char *pieces[] = {"{RED}", "{BLOCK}", "uwu ", "{NORMAL}\n",
+							"{UNKNOWN}", "{"};
+	for (int i = 0;
+		 strbuf_append(&buf, pieces[i % 6], strlen(pieces[i % 6])) == 0; i++)
+		;
+	double start = seconds();
+	for (int r = 0; r < rounds / 10 + 1; r++) expand_logo(logo, buf.len);
+	flush_output();
+	fprintf(stderr, "%6zu byte logo: %10.1f us\n", buf.len,
+			(seconds() - start) * 1e6 / (rounds / 10 + 1));
+	free(logo);
+	return failed;
+}
@@ -0,0 +1,39 @@
+#!/bin/sh
+# Counts the syscalls uwufetch makes while printing to a terminal, for the
+# current tree and, when given, for another git revision to compare with:
+#     bench/syscalls.sh [revision]
+# Needs strace and script (util-linux), stdout must be a tty because stdio
+# only flushes every line there.
+
+for tool in strace script; do
+	command -v $tool > /dev/null || {
+		echo "$0: $tool is needed to count the syscalls" >&2
+		exit 1
+	}
+done
+cd "$(dirname "$0")/.." || exit 1
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+count() { # name binary
+	script -qec "strace -f -o $tmp/$1.trace $2 -d arch" /dev/null > /dev/null
+	printf "%-10s %4d writes to stdout, %5d syscalls\n" "$1" \
+		"$(grep -c 'write(1,' "$tmp/$1.trace")" \
+		"$(grep -vc -e '^[0-9]* *+++' -e '^[0-9]* *---' "$tmp/$1.trace")"
+}
+
+# the older revision uses them too, if it needs them
+make -s logos.h distros.h || exit 1
+${CC:-cc} -O3 -pthread -o "$tmp/current" uwufetch.c fetch.c -ldl || exit 1
+if [ -n "$1" ]; then
+	mkdir "$tmp/before.src"
+	git show "$1:uwufetch.c" > "$tmp/before.src/uwufetch.c" || exit 1
+	for file in fetch.c fetch.h uwufetch.h; do # since the library split
+		git show "$1:$file" > "$tmp/before.src/$file" 2> /dev/null ||
+			rm "$tmp/before.src/$file"
+	done
+	${CC:-cc} -O3 -pthread -I. -o "$tmp/before" "$tmp"/before.src/*.c -ldl ||
+		exit 1
+	count "$1" "$tmp/before"
+fi
+count current "$tmp/current"
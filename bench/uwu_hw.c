@@ -0,0 +1,175 @@
+/*
+ Compares uwu_hw() with the replace_ignorecase() chain it replaced, on real
+hardware names and on random ones made of pieces of the names, then times
+both. Build and run with make bench_uwu_hw.
+*/
+#define main uwufetch_main
+#include "../fetch.c"
+#include "../uwufetch.c"
+#undef main
+
+// the old implementation, kept here as the reference
+void old_replace_ignorecase(char *original, char *search, char *replacer) {
+	char *ch;
+	char buffer[1024];
+	while ((ch = strcasestr(original, search))) {
+		strncpy(buffer, original, ch - original);
+		buffer[ch - original] = 0;
+		sprintf(buffer + (ch - original), "%s%s", replacer,
+				ch + strlen(search));
+		original[0] = 0;
+		strcpy(original, buffer);
+	}
+}
+
+void old_uwu_hw(char *hwname) {
+#define HW_TO_UWU(original, uwuified) \
+	old_replace_ignorecase(hwname, original, uwuified);
+	HW_TO_UWU("lenovo", "LenOwO")
+	HW_TO_UWU("cpu", "CC\bPUwU")
+	HW_TO_UWU("gpu", "GG\bPUwU")
+	HW_TO_UWU("graphics", "Gwaphics")
+	HW_TO_UWU("corporation", "COwOpowation")
+	HW_TO_UWU("nvidia", "NyaVIDIA")
+	HW_TO_UWU("mobile", "Mwobile")
+	HW_TO_UWU("intel", "Inteww")
+	HW_TO_UWU("radeon", "Radenyan")
+	HW_TO_UWU("geforce", "GeFOwOce")
+	HW_TO_UWU("raspberry", "Nyasberry")
+	HW_TO_UWU("broadcom", "Bwoadcom")
+	HW_TO_UWU("motorola", "MotOwOwa")
+	HW_TO_UWU("proliant", "ProLinyant")
+	HW_TO_UWU("poweredge", "POwOwEdge")
+	HW_TO_UWU("apple", "Nyaa\bpple")
+	HW_TO_UWU("electronic", "ElectrOwOnic")
+#undef HW_TO_UWU
+}
+
+// what the terminal shows: a \b deletes the character before it
+void apply_backspaces(char *str) {
+	char *out = str;
+	for (char *c = str; *c; c++)
+		if (*c == '\b') {
+			if (out > str) out--;
+		} else
+			*out++ = *c;
+	*out = '\0';
+}
+
+char *corpus[] = {
+	"Intel(R) Core(TM) i7-8550U CPU @ 1.80GHz",
+	"AMD Ryzen 9 5950X 16-Core Processor",
+	"NVIDIA Corporation GA102 [GeForce RTX 3090]",
+	"Intel Corporation UHD Graphics 620",
+	"Advanced Micro Devices, Inc. [AMD/ATI] Navi 21 [Radeon RX 6800]",
+	"LENOVO 20KHCTO1WW ThinkPad X1 Carbon 6th",
+	"Raspberry Pi 4 Model B Rev 1.4",
+	"Broadcom BCM2711",
+	"HP ProLiant DL380 Gen10",
+	"Dell Inc. PowerEdge R740",
+	"Apple M1 Pro",
+	"Motorola moto g(7) power",
+	"Samsung Electronics Co Ltd NVMe SSD Controller",
+	"NVIDIA GeForce GTX 1650 Mobile / Max-Q",
+	"Intel(R) Xeon(R) CPU E5-2680 v4 @ 2.40GHz",
+	"llvmpipe (LLVM 15.0.6, 256 bits)",
+	"gpu cpu GPU CPU Gpu Cpu",
+	"",
+};
+
+// random names made of pieces of the hardware names, in random case
+void random_name(char *name, unsigned *seed) {
+	static const char *pieces[] = {
+		"intel", "inte", "el", "cpu", "cp", "gpu", "apple", "appl",
+		"geforce", "electronic", "tronic", "corporation", "nvidia",
+		"radeon", "mobile", "lenovo", "poweredge", "power", " ", "(R)",
+		"-", "x", "proliant", "motorola", "broadcom", "raspberry",
+		"graphics", "ics"};
+	int count = rand_r(seed) % 8;
+	name[0]	  = '\0';
+	for (int i = 0; i < count; i++)
+		strcat(name, pieces[rand_r(seed) % (sizeof(pieces) / sizeof(*pieces))]);
+	for (char *c = name; *c; c++)
+		if (rand_r(seed) % 2) *c = toupper(*c);
+}
+
+/*
+ The old chain rewrote one name at a time, so where two names overlap (like
+"intelenovo") the result depended on their order and on the text already
+replaced. The single pass takes the name that ends first, those differences
+are expected.
+*/
+int has_overlapping_names(const char *name) {
+	int starts[256], ends[256], count = 0;
+	for (int i = 0; i < HW_NAME_COUNT; i++)
+		for (const char *found = name;
+			 count < 256 && (found = strcasestr(found, hw_names[i].original));
+			 found++) {
+			starts[count] = found - name;
+			ends[count++] = found - name + strlen(hw_names[i].original);
+		}
+	for (int i = 0; i < count; i++)
+		for (int j = 0; j < count; j++)
+			if (i != j && starts[i] < ends[j] && starts[j] < ends[i])
+				return 1;
+	return 0;
+}
+
+double seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+	int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+	unsigned seed  = 42;
+	int checked = 0, mismatches = 0, overlapping = 0;
+	char name[256], old[1024], new[256];
+	const int corpus_size = sizeof(corpus) / sizeof(corpus[0]);
+
+	for (int i = 0; i < corpus_size + iterations; i++) {
+		if (i < corpus_size)
+			sprintf(name, "%s", corpus[i]);
+		else
+			random_name(name, &seed);
+		sprintf(old, "%s", name);
+		sprintf(new, "%s", name);
+		old_uwu_hw(old);
+		apply_backspaces(old);
+		uwu_hw(new, sizeof(new));
+		checked++;
+		if (strcmp(old, new) == 0) continue;
+		if (has_overlapping_names(name)) {
+			overlapping++;
+			continue;
+		}
+		if (mismatches++ < 10)
+			printf("mismatch: \"%s\"\n   old: \"%s\"\n   new: \"%s\"\n", name,
+				   old, new);
+	}
+	printf("%d names checked, %d mismatches, %d expected differences with "
+		   "overlapping names\n",
+		   checked, mismatches, overlapping);
+
+	const int rounds = 20000;
+	double start	 = seconds();
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < corpus_size; i++) {
+			sprintf(old, "%s", corpus[i]);
+			old_uwu_hw(old);
+		}
+	double old_time = seconds() - start;
+	start			= seconds();
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < corpus_size; i++) {
+			sprintf(new, "%s", corpus[i]);
+			uwu_hw(new, sizeof(new));
+		}
+	double new_time = seconds() - start;
+	printf("replace_ignorecase chain: %8.1f ns per name\n"
+		   "single pass:              %8.1f ns per name\n",
+		   old_time * 1e9 / rounds / corpus_size,
+		   new_time * 1e9 / rounds / corpus_size);
+	return mismatches != 0;
+}
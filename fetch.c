@@ -0,0 +1,2990 @@
+/*
+ *  UwUfetch is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fetch.h"
+
+#ifdef _WIN32
+CONSOLE_SCREEN_BUFFER_INFO csbi;
+#endif // _WIN32
+
+// {NAME} placeholders of the logo files, sorted for bsearch()
+#define LOGO_TOKENS                                                    \
+	X(BACKGROUND_GREEN) X(BACKGROUND_RED) X(BACKGROUND_WHITE) X(BLACK)     \
+	X(BLOCK) X(BLOCK_VERTICAL) X(BLUE) X(BOLD) X(CYAN) X(GREEN) X(LPINK)   \
+	X(MAGENTA) X(NORMAL) X(PINK) X(RED) X(SPRING_GREEN) X(WHITE) X(YELLOW)
+
+// logos built into the binary, the placeholders are already expanded
+struct logo {
+	const char *name, *art;
+} logos[] = {
+#include "logos.h" // generated from res/ascii by make
+};
+#define LOGO_COUNT (sizeof(logos) / sizeof(logos[0]))
+
+// uwufied names of distributions and kernels, sorted for bsearch()
+struct distro_name {
+	const char *name, *uwu;
+} distro_names[] = {
+#include "distros.h" // generated from res/distros by make
+};
+#define DISTRO_NAME_COUNT (sizeof(distro_names) / sizeof(distro_names[0]))
+// printed instead of the value of a probe that took too long
+#ifdef _WIN32
+	#define TIMED_OUT "..."
+#else // _WIN32
+	#define TIMED_OUT "\u2026"
+#endif // _WIN32
+
+struct package_manager {
+	char command_string[128]; // command to get number of packages installed
+	char pkgman_name[16];	  // name of the package manager
+	int (*native_count)(void); // reads the package database directly, when
+							   // set the command is never executed
+};
+
+// initialise the variables to store data
+// int target_width = 0, screen_width = 0, screen_height = 0, ram_total,
+// ram_used = 0, pkgs = 0; long uptime = 0;
+
+// the globals declared in fetch.h
+char *field_names[FIELD_COUNT] = {"os",	 "user", "host",		"cpu", "kernel",
+								  "ram", "gpu",	 "resolution", "pkgs"};
+char output_data[OUTPUT_SIZE];
+struct output terminal_output = {{output_data, 0, OUTPUT_SIZE}, 1, 0};
+_Thread_local struct output *output = &terminal_output;
+struct profile profile = {0, 0, 0, 0, {{"", 0, 0}}, PTHREAD_MUTEX_INITIALIZER};
+#ifndef _WIN32
+long probe_timeout = PROBE_TIMEOUT, collect_deadline = 0;
+#endif // _WIN32
+
+long monotonic_us(void) {
+#ifndef _WIN32
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#else  // _WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return counter.QuadPart * 1000000 / frequency.QuadPart;
+#endif // _WIN32
+}
+
+// returns the start of a stage for profile_end(), 0 when not profiling
+long profile_begin(void) {
+	return profile.enabled ? monotonic_us() : 0;
+}
+
+// adds the time since start to the stage named by format, the calls with the
+// same name are summed
+void profile_end(long start, const char *format, ...) {
+	if (!profile.enabled) return;
+	long us = monotonic_us() - start;
+	char name[sizeof(profile.stages[0].name)];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(name, sizeof(name), format, args);
+	va_end(args);
+	pthread_mutex_lock(&profile.lock);
+	int i = 0;
+	while (i < profile.count && strcmp(profile.stages[i].name, name) != 0) i++;
+	if (i == profile.count && profile.count < PROFILE_STAGES)
+		strcpy(profile.stages[profile.count++].name, name);
+	if (i < profile.count) {
+		profile.stages[i].us += us;
+		profile.stages[i].calls++;
+	}
+	pthread_mutex_unlock(&profile.lock);
+}
+
+int compare_profile_stage(const void *a, const void *b) {
+	long us_a = ((const struct profile_stage *)a)->us,
+		 us_b = ((const struct profile_stage *)b)->us;
+	return (us_a < us_b) - (us_a > us_b); // the slowest first
+}
+
+/*
+ Prints the stages sorted by time. The collectors run at the same time and
+some stages contain others (a package manager is part of "collect pkgs"), so
+the stages add up to more than the total.
+*/
+void print_profile(void) {
+	long total = monotonic_us() - profile.start;
+	qsort(profile.stages, profile.count, sizeof(profile.stages[0]),
+		  compare_profile_stage);
+	if (profile.json) {
+		fprintf(stderr, "{\"total_us\": %ld, \"stages\": [", total);
+		for (int i = 0; i < profile.count; i++)
+			fprintf(stderr, "%s{\"name\": \"%s\", \"us\": %ld, \"calls\": %d}",
+					i ? ", " : "", profile.stages[i].name,
+					profile.stages[i].us, profile.stages[i].calls);
+		fprintf(stderr, "]}\n");
+		return;
+	}
+	fprintf(stderr, "%10.3f ms  total\n", total / 1000.0);
+	for (int i = 0; i < profile.count; i++) {
+		fprintf(stderr, "%10.3f ms  %s", profile.stages[i].us / 1000.0,
+				profile.stages[i].name);
+		if (profile.stages[i].calls > 1)
+			fprintf(stderr, " (%d calls)", profile.stages[i].calls);
+		fprintf(stderr, "\n");
+	}
+}
+
+/*
+ With UWUFETCH_ROOT=<dir> the system files (/etc, /proc, /sys and the package
+databases) are read below dir instead of /, so that a copy of another system
+can be fetched, like the fixture of make bench. Commands, uname() and the
+config and cache files are not affected.
+*/
+const char *root_path(const char *path, char *buf, size_t size) {
+	const char *root = getenv("UWUFETCH_ROOT");
+	if (!root || !root[0] || path[0] != '/') return path;
+	snprintf(buf, size, "%s%s", root, path);
+	return buf;
+}
+
+FILE *root_fopen(const char *path, const char *mode) {
+	char buf[1024];
+	return fopen(root_path(path, buf, sizeof(buf)), mode);
+}
+
+DIR *root_opendir(const char *path) {
+	char buf[1024];
+	return opendir(root_path(path, buf, sizeof(buf)));
+}
+
+#ifndef _WIN32
+int root_open(const char *path, int flags) {
+	char buf[1024];
+	return open(root_path(path, buf, sizeof(buf)), flags);
+}
+
+long monotonic_ms(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// the process groups of the running probes, so that get_info() can kill the
+// ones that are still running when it stops waiting for their collectors
+struct {
+	pid_t pids[MAX_PROBES];
+	int count;
+	pthread_mutex_t lock;
+} probes = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+void add_probe(pid_t pid) {
+	pthread_mutex_lock(&probes.lock);
+	if (probes.count < MAX_PROBES) probes.pids[probes.count++] = pid;
+	pthread_mutex_unlock(&probes.lock);
+}
+
+// before the probe is reaped, its pid can then never be the one of another
+// process when kill_probes() uses it
+void remove_probe(pid_t pid) {
+	pthread_mutex_lock(&probes.lock);
+	for (int i = 0; i < probes.count; i++)
+		if (probes.pids[i] == pid) {
+			probes.pids[i] = probes.pids[--probes.count];
+			break;
+		}
+	pthread_mutex_unlock(&probes.lock);
+}
+
+void kill_probes(void) {
+	pthread_mutex_lock(&probes.lock);
+	for (int i = 0; i < probes.count; i++) kill(-probes.pids[i], SIGKILL);
+	pthread_mutex_unlock(&probes.lock);
+}
+
+/*
+ Runs probe(arg) in a child process whose stdout is a pipe, and waits for it
+only until the probe deadline: if the child is still running at that point it
+gets killed and NULL is returned, otherwise its whole output is returned as an
+in-memory file. The probe deadline ends PROBE_MARGIN before the collect
+deadline, so that the collector still has the time to keep what it found.
+*/
+FILE *probe_fork(void (*probe)(void *arg), void *arg) {
+	int fds[2];
+	// other collectors fork too, they must not keep this pipe open
+#ifdef __APPLE__ // no pipe2()
+	if (pipe(fds) != 0) return NULL;
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#else
+	if (pipe2(fds, O_CLOEXEC) != 0) return NULL;
+#endif // __APPLE__
+	pid_t pid = fork();
+	if (pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return NULL;
+	}
+	if (pid == 0) {
+		setpgid(0, 0); // a new process group, to kill the whole pipeline
+		dup2(fds[1], STDOUT_FILENO);
+		probe(arg);
+		_exit(0);
+	}
+	setpgid(pid, pid);
+	add_probe(pid);
+	close(fds[1]);
+
+	long deadline = monotonic_ms() + probe_timeout;
+	if (collect_deadline && collect_deadline - PROBE_MARGIN < deadline)
+		deadline = collect_deadline - PROBE_MARGIN;
+	char *output = NULL;
+	size_t len = 0, size = 0;
+	int timed_out = 0;
+	while (1) {
+		long remaining = deadline - monotonic_ms();
+		struct pollfd pipe_poll = {fds[0], POLLIN, 0};
+		int ready = remaining > 0 ? poll(&pipe_poll, 1, remaining) : 0;
+		if (ready < 0 && errno == EINTR) continue; // with the time left
+		if (ready <= 0) {
+			timed_out = 1;
+			break;
+		}
+		if (len == size) {
+			char *bigger = realloc(output, size += 4096);
+			if (!bigger) break;
+			output = bigger;
+		}
+		ssize_t count = read(fds[0], output + len, size - len);
+		if (count < 0 && errno == EINTR) continue;
+		if (count <= 0) break;
+		len += count;
+	}
+	close(fds[0]);
+	if (timed_out) kill(-pid, SIGKILL);
+	remove_probe(pid);
+	int status = 0;
+	while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+	// killed by kill_probes(), what it printed until then is not complete
+	if (WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL) timed_out = 1;
+
+	FILE *fp = NULL;
+	if (!timed_out) {
+		fp = fmemopen(NULL, len + 1, "w+"); // the buffer is freed by fclose()
+		if (fp) {
+			fwrite(output, 1, len, fp);
+			rewind(fp);
+		}
+	}
+	free(output);
+	return fp;
+}
+
+extern char **environ;
+
+struct shell_command {
+	const char *command;
+	char **env;
+};
+
+void run_shell(void *arg) {
+	struct shell_command *shell = arg;
+	execle("/bin/sh", "sh", "-c", shell->command, (char *)NULL, shell->env);
+	_exit(127);
+}
+
+// runs a shell command like popen(), with the deadline of probe_fork()
+FILE *probe_popen(const char *command) {
+	// force language to english, only for the command: the process can be a
+	// program using libuwufetch. The environment is made before fork(), the
+	// child of a process with threads must not allocate.
+	size_t count = 0, kept = 0;
+	while (environ[count]) count++;
+	char **env = malloc((count + 2) * sizeof(*env));
+	if (!env) return NULL;
+	for (size_t i = 0; i < count; i++)
+		if (strncmp(environ[i], "LANG=", 5) != 0) env[kept++] = environ[i];
+	env[kept++]					= "LANG=en_US";
+	env[kept]					= NULL;
+	struct shell_command shell = {command, env};
+	FILE *fp					= probe_fork(run_shell, &shell);
+	free(env);
+	return fp;
+}
+#endif // _WIN32
+
+#if !defined(__APPLE__) && !defined(_WIN32)
+// counts the lines of a file starting with prefix and ending with suffix,
+// leading whitespace is only skipped in indented files: in the dpkg database
+// a line starting with a space continues the previous field
+int count_lines(const char *path, const char *prefix, const char *suffix,
+				int indented) {
+	FILE *fp = root_fopen(path, "r");
+	if (!fp) return 0;
+	char line[512];
+	int count = 0, line_start = 1;
+	size_t prefix_len = strlen(prefix), suffix_len = strlen(suffix);
+	while (fgets(line, sizeof(line), fp)) {
+		size_t len = strlen(line);
+		int is_start = line_start; // long lines are read in more pieces
+		line_start	 = len > 0 && line[len - 1] == '\n';
+		if (!is_start) continue;
+		if (line_start) line[--len] = '\0';
+		char *start = indented ? line + strspn(line, " \t") : line;
+		len -= start - line;
+		if (strncmp(start, prefix, prefix_len) == 0 && len >= suffix_len &&
+			strcmp(start + len - suffix_len, suffix) == 0)
+			count++;
+	}
+	fclose(fp);
+	return count;
+}
+
+// counts the directories found depth levels below path (depth 1 means the
+// direct subdirectories), symlinks and hidden entries are skipped, the path is
+// used as it is, without UWUFETCH_ROOT
+int count_dirs_at(const char *path, int depth) {
+	DIR *dir = opendir(path);
+	if (!dir) return 0;
+	struct dirent *entry;
+	int count = 0;
+	while ((entry = readdir(dir))) {
+		if (entry->d_name[0] == '.') continue;
+		char subdir[1024];
+		if (snprintf(subdir, sizeof(subdir), "%s/%s", path, entry->d_name) >=
+			(int)sizeof(subdir))
+			continue;
+		if (entry->d_type == DT_UNKNOWN) { // some filesystems do not fill d_type
+			struct stat st;
+			if (lstat(subdir, &st) != 0 || !S_ISDIR(st.st_mode)) continue;
+		} else if (entry->d_type != DT_DIR)
+			continue;
+		count += depth > 1 ? count_dirs_at(subdir, depth - 1) : 1;
+	}
+	closedir(dir);
+	return count;
+}
+
+// the same, for a path of the system
+int count_dirs(const char *path, int depth) {
+	char buf[1024];
+	return count_dirs_at(root_path(path, buf, sizeof(buf)), depth);
+}
+
+int pkgs_dpkg(void) {
+	return count_lines("/var/lib/dpkg/status", "Status: ", " installed", 0);
+}
+
+int pkgs_apk(void) {
+	return count_lines("/lib/apk/db/installed", "P:", "", 0);
+}
+
+int pkgs_emerge(void) { return count_dirs("/var/db/pkg", 2); } // category/pkg
+
+int pkgs_pacman(void) { return count_dirs("/var/lib/pacman/local", 1); }
+
+int pkgs_xbps(void) {
+	return count_lines("/var/db/xbps/pkgdb-0.38.plist",
+					   "<string>installed</string>", "", 1);
+}
+
+int pkgs_flatpak(void) { // installations are stored as <name>/<arch>/<branch>
+	int count = count_dirs("/var/lib/flatpak/app", 3) +
+				count_dirs("/var/lib/flatpak/runtime", 3);
+	// the user installations are in $HOME like the config and the cache, so
+	// UWUFETCH_ROOT does not apply to them
+	const char *user_dirs[] = {"app", "runtime"};
+	for (int i = 0; getenv("HOME") && i < 2; i++) {
+		char user_dir[512];
+		if (snprintf(user_dir, sizeof(user_dir), "%s/.local/share/flatpak/%s",
+					 getenv("HOME"), user_dirs[i]) < (int)sizeof(user_dir))
+			count += count_dirs_at(user_dir, 3);
+	}
+	return count;
+}
+
+int pkgs_snap(void) { // every snap is mounted in its own directory, next to
+					 // the bin directory holding the command wrappers
+	const char *snap_dirs[] = {"/snap", "/var/lib/snapd/snap"};
+	for (int i = 0; i < 2; i++) {
+		int count = count_dirs(snap_dirs[i], 1);
+		if (count == 0) continue;
+		char bin_dir[64], buf[1024];
+		sprintf(bin_dir, "%s/bin", snap_dirs[i]);
+		root_path(bin_dir, buf, sizeof(buf));
+		return count - (access(buf, F_OK) == 0);
+	}
+	return 0;
+}
+#endif // !defined(__APPLE__) && !defined(_WIN32)
+
+#ifdef _WIN32
+int pkgman(struct info *user_info, struct configuration *config_flags)
+#else // _WIN32
+int pkgman(struct info *user_info)
+#endif
+{ // this is just a function that returns the total of installed packages
+	int total = 0;
+
+#ifndef __APPLE__ // this function is not used on mac os because it causes lots \
+				  // of problems
+	#ifndef _WIN32
+	// package managers with a native reader are counted from their database
+	// files, the others still need a shell command
+	struct package_manager pkgmans[] = {
+		{"", "(apt)", pkgs_dpkg},
+		{"", "(apk)", pkgs_apk},
+		{"dnf list installed 2> /dev/null | wc -l", "(dnf)", NULL},
+		{"", "(emerge)", pkgs_emerge},
+		{"", "(flatpak)", pkgs_flatpak},
+		{"", "(snap)", pkgs_snap},
+		{"guix package --list-installed 2> /dev/null | wc -l", "(guix)", NULL},
+		{"nix-store -q --requisites /run/current-system/sw 2> /dev/null | wc "
+		 "-l",
+		 "(nix)", NULL},
+		{"", "(pacman)", pkgs_pacman},
+		{"pkg info 2>/dev/null | wc -l", "(pkg)", NULL},
+		{"port installed 2> /dev/null | tail -n +2 | wc -l", "(port)", NULL},
+		{"rpm -qa --last 2> /dev/null | wc -l", "(rpm)", NULL},
+		{"", "(xbps)", pkgs_xbps},
+		{"zypper -q se --installed-only 2> /dev/null | wc -l", "(zypper)",
+		 NULL}};
+	const unsigned long pkgman_count = sizeof(pkgmans) / sizeof(pkgmans[0]);
+	// the package managers that were found, "<count> (<name>), ..."
+	char names_data[256] = "";
+	struct strbuf names	 = strbuf_wrap(names_data, sizeof(names_data));
+	for (long unsigned int i = 0; i < pkgman_count;
+		 i++) { // long unsigned int instead of int because of -Wsign-compare
+		struct package_manager *current = &pkgmans[i];
+		unsigned int pkg_count			= 0;
+		long start						= profile_begin();
+
+		if (current->native_count)
+			pkg_count = current->native_count();
+		else {
+			FILE *fp = probe_popen(current->command_string);
+			if (!fp) { // the count is unknown, but the others are still shown
+				profile_end(start, "pkgs %s", current->pkgman_name);
+				strbuf_printf(&names, "%s" TIMED_OUT " %s",
+							  names.len ? ", " : "", current->pkgman_name);
+				continue;
+			}
+			if (fscanf(fp, "%u", &pkg_count) == 3) continue;
+			probe_pclose(fp);
+		}
+		profile_end(start, "pkgs %s", current->pkgman_name);
+
+		total += pkg_count;
+		// this is the line that breaks mac os, but something strange happens
+		// before
+		if (pkg_count > 0)
+			strbuf_printf(&names, "%s%u %s", names.len ? ", " : "", pkg_count,
+						  current->pkgman_name);
+	}
+	user_info->pkgman_name = arena_add(&user_info->strings, names.data);
+	#else  // _WIN32
+	if (config_flags->show_pkgs) {
+		FILE *fp = popen("choco list -l --no-color 2> nul", "r");
+		unsigned int pkg_count;
+		char buffer[7562] = {0};
+		while (fgets(buffer, sizeof(buffer), fp)) {
+			sscanf(buffer, "%u packages installed.", &pkg_count);
+		}
+		if (fp) pclose(fp);
+
+		total = pkg_count;
+		char names[32];
+		snprintf(names, sizeof(names), "%u (chocolatey)", pkg_count);
+		user_info->pkgman_name = arena_add(&user_info->strings, names);
+	}
+	#endif // _WIN32
+
+#endif
+	return total;
+}
+
+#ifdef __APPLE__
+int uptime_apple() {
+	int mib[2] = {CTL_KERN, KERN_BOOTTIME};
+	struct timeval time_buffer;
+	size_t time_buffer_len = sizeof(time_buffer);
+	sysctl(mib, 2, &time_buffer, &time_buffer_len, NULL, 0);
+
+	time_t bsec = time_buffer.tv_sec;
+	time_t csec = time(NULL);
+
+	return difftime(csec, bsec);
+}
+#endif
+
+#ifdef __FREEBSD__
+int uptime_freebsd() { // this code is from coreutils uptime:
+					   // https://github.com/coreutils/coreutils/blob/master/src/uptime.c
+	int boot_time		  = 0;
+	static int request[2] = {CTL_KERN, KERN_BOOTTIME};
+	struct timeval result;
+	size_t result_len = sizeof result;
+
+	if (sysctl(request, 2, &result, &result_len, NULL, 0) >= 0)
+		boot_time = result.tv_sec;
+	int time_now = time(NULL);
+	return time_now - boot_time;
+}
+#endif
+
+// the seconds since boot, only read once and kept in user_info
+long get_uptime(struct info *user_info) {
+	if (user_info->uptime == 0) {
+#ifdef __APPLE__
+		user_info->uptime = uptime_apple();
+#else
+	#ifdef __FREEBSD__
+		user_info->uptime = uptime_freebsd();
+	#else
+		#ifdef _WIN32
+		user_info->uptime = GetTickCount() / 1000;
+		#else  // _WIN32
+		user_info->uptime = user_info->sys.uptime;
+		#endif // _WIN32
+	#endif
+#endif
+	}
+	return user_info->uptime;
+}
+
+void print_info(struct configuration *config_flags, struct info *user_info) {
+	long start = profile_begin();
+#ifdef _WIN32
+	#define responsively_printf(format, ...) \
+		out_line(user_info->ws_col - 1, format, __VA_ARGS__)
+#else // _WIN32
+	#define responsively_printf(format, ...) \
+		out_line(user_info->win.ws_col - 1, format, __VA_ARGS__)
+#endif // _WIN32
+	// the info starts after the logo, the windows one is narrower
+	const char *terminal_cursor_move =
+		strcmp(user_info->version_name, "windows") ? "\033[21C" : "\033[18C";
+
+	// print collected info - from host to cpu info
+	out_printf("\033[9A"); // to align info text
+	if (config_flags->show_user_info)
+		responsively_printf("%s%s%s%s@%s", terminal_cursor_move,
+							NORMAL, BOLD, user_info->user, user_info->host);
+	uwu_name(config_flags, user_info);
+	if (config_flags->show_os)
+		responsively_printf("%s%s%sOWOS        %s%s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->version_name);
+	if (config_flags->show_host)
+		responsively_printf("%s%s%sHOWOST      %s%s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->host_model);
+	if (config_flags->show_kernel)
+		responsively_printf("%s%s%sKEWNEL      %s%s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->kernel);
+	if (config_flags->show_cpu)
+		responsively_printf("%s%s%sCPUWU       %s%s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->cpu_model);
+
+	// print the gpus
+	if (config_flags->show_gpu)
+		STRING_TABLE_FOREACH(&user_info->gpu_model, gpu)
+			responsively_printf("%s%s%sGPUWU       %s%s",
+								terminal_cursor_move, NORMAL, BOLD, NORMAL,
+								gpu);
+
+	// print ram to uptime and colors
+	if (config_flags->show_ram) {
+		if (user_info->ram_total < 0) {
+			responsively_printf("%s%s%sWAM         %s%s",
+								terminal_cursor_move, NORMAL, BOLD, NORMAL,
+								TIMED_OUT);
+		} else
+			responsively_printf("%s%s%sWAM         %s%i MiB/%i MiB",
+								terminal_cursor_move, NORMAL, BOLD, NORMAL,
+								(user_info->ram_used), user_info->ram_total);
+	}
+	if (config_flags->show_swap)
+		responsively_printf("%s%s%sSWAWP       %s%i MiB/%i MiB",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->swap_used, user_info->swap_total);
+	if (config_flags->show_buff_cache)
+		responsively_printf("%s%s%sBUFF/CACHWE %s%i MiB",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->buff_cache);
+	if (config_flags->show_hugepages)
+		responsively_printf("%s%s%sHUWUGEPAGES %s%i MiB/%i MiB",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->hugepages_used,
+							user_info->hugepages_total);
+	if (config_flags->show_resolution && user_info->screen_count > 0) {
+		char screens_data[MAX_SCREENS * 24] = ""; // "WxH, WxH, ..."
+		struct strbuf screens = strbuf_wrap(screens_data, sizeof(screens_data));
+		for (int i = 0; i < user_info->screen_count; i++)
+			strbuf_printf(&screens, "%s%dx%d", i ? ", " : "",
+						  user_info->screens[i].width,
+						  user_info->screens[i].height);
+		responsively_printf("%s%s%sRESOWUTION%s  %s", terminal_cursor_move,
+							NORMAL, BOLD, NORMAL, screens.data);
+	}
+	if (config_flags->show_shell)
+		responsively_printf("%s%s%sSHEWW       %s%s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL,
+							user_info->shell);
+#if defined(__APPLE__) && !defined(TARGET_OS_IPHONE)
+	if (show_pkgs) {
+		flush_output(); // the command writes straight to the terminal
+		system(
+			"ls $(brew --cellar) | wc -l | awk -F' ' '{print \"  \x1b[34mw     "
+			"    w     \x1b[0m\x1b[1mPKGS\x1b[0m        \"$1 \" (brew)\"}'");
+	}
+#else
+	if (config_flags->show_pkgs)
+		responsively_printf("%s%s%sPKGS        %s%s%d: %s",
+							terminal_cursor_move, NORMAL, BOLD, NORMAL, NORMAL,
+							user_info->pkgs, user_info->pkgman_name);
+#endif
+	if (config_flags->show_uptime) {
+		switch (get_uptime(user_info)) {
+		case 0 ... 3599:
+			responsively_printf("%s%s%sUWUPTIME    %s%lim",
+								terminal_cursor_move, NORMAL, BOLD, NORMAL,
+								user_info->uptime / 60 % 60);
+			break;
+		case 3600 ... 86399:
+			responsively_printf("%s%s%sUWUPTIME    %s%lih, %lim",
+								terminal_cursor_move, NORMAL, BOLD, NORMAL,
+								user_info->uptime / 3600,
+								user_info->uptime / 60 % 60);
+			break;
+		default:
+			responsively_printf(
+				"%s%s%sUWUPTIME    %s%lid, %lih, %lim",
+				terminal_cursor_move, NORMAL, BOLD, NORMAL,
+				user_info->uptime / 86400, user_info->uptime / 3600 % 24,
+				user_info->uptime / 60 % 60);
+		}
+	}
+	if (config_flags->show_colors)
+		out_printf("%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s\n",
+				   terminal_cursor_move, BOLD, BLACK, BLOCK_CHAR, BLOCK_CHAR, RED,
+				   BLOCK_CHAR, BLOCK_CHAR, GREEN, BLOCK_CHAR, BLOCK_CHAR, YELLOW,
+				   BLOCK_CHAR, BLOCK_CHAR, BLUE, BLOCK_CHAR, BLOCK_CHAR, MAGENTA,
+				   BLOCK_CHAR, BLOCK_CHAR, CYAN, BLOCK_CHAR, BLOCK_CHAR, WHITE,
+				   BLOCK_CHAR, BLOCK_CHAR, NORMAL);
+	profile_end(start, "render");
+}
+
+// writes a value without its quotes, control characters can not end a line
+void format_escaped(int format, const char *value) {
+	for (; *value; value++) {
+		unsigned char c = *value;
+		if (c < ' ' && format == FORMAT_JSON)
+			out_printf("\\u%04x", c);
+		else if (c < ' ')
+			out_write(" ", 1);
+		else if (format == FORMAT_JSON && (c == '"' || c == '\\'))
+			out_printf("\\%c", c);
+		else if (format == FORMAT_ENV && c == '\'')
+			out_write("'\\''", 4);
+		else
+			out_write(value, 1);
+	}
+}
+
+void format_value(int format, const char *value) {
+	const char *quote = format == FORMAT_JSON	? "\""
+						: format == FORMAT_ENV ? "'"
+											   : "";
+	out_printf("%s", quote);
+	format_escaped(format, value);
+	out_printf("%s", quote);
+}
+
+// starts the line of a field, env names are upper case with a prefix
+void format_key(int format, int *count, const char *key) {
+	if (format == FORMAT_JSON)
+		out_printf("%s\n\t\"%s\": ", (*count)++ ? "," : "", key);
+	else if (format == FORMAT_KV)
+		out_printf("%s=", key);
+	else {
+		out_printf("UWUFETCH_");
+		for (; *key; key++) out_printf("%c", toupper((unsigned char)*key));
+		out_printf("=");
+	}
+}
+
+void format_string(int format, int *count, const char *key,
+				   const char *value) {
+	format_key(format, count, key);
+	format_value(format, value ? value : "");
+	if (format != FORMAT_JSON) out_printf("\n");
+}
+
+void format_number(int format, int *count, const char *key, long value) {
+	format_key(format, count, key);
+	out_printf("%ld%s", value, format == FORMAT_JSON ? "" : "\n");
+}
+
+/*
+ Prints the collected info for scripts, without logo, colors or cursor
+escapes. The fields are the ones print_info() shows, with their raw values:
+json is a single object with the gpus and screens as arrays, kv has a
+key=value line per field and repeats gpu= for every gpu, env has shell
+assignments that can be eval'd, with the gpus on separate lines of
+UWUFETCH_GPU. The numbers are MiB and seconds.
+*/
+void print_format(struct configuration *config_flags, struct info *user_info) {
+	long start = profile_begin();
+	int format = config_flags->output_format, count = 0;
+	if (format == FORMAT_JSON) out_printf("{");
+	if (config_flags->show_user_info) {
+		format_string(format, &count, "user", user_info->user);
+		format_string(format, &count, "host", user_info->host);
+	}
+	if (config_flags->show_os)
+		format_string(format, &count, "os", user_info->version_name);
+	if (config_flags->show_host)
+		format_string(format, &count, "host_model", user_info->host_model);
+	if (config_flags->show_kernel)
+		format_string(format, &count, "kernel", user_info->kernel);
+	if (config_flags->show_cpu)
+		format_string(format, &count, "cpu", user_info->cpu_model);
+	if (config_flags->show_gpu) {
+		if (format == FORMAT_KV) {
+			STRING_TABLE_FOREACH(&user_info->gpu_model, gpu)
+				format_string(format, &count, "gpu", gpu);
+		} else { // a json array, or a line per gpu for env
+			format_key(format, &count, "gpu");
+			out_printf(format == FORMAT_JSON ? "[" : "'");
+			int i = 0;
+			STRING_TABLE_FOREACH(&user_info->gpu_model, gpu) {
+				if (i++) out_printf(format == FORMAT_JSON ? ", " : "\n");
+				if (format == FORMAT_JSON) out_printf("\"");
+				format_escaped(format, gpu);
+				if (format == FORMAT_JSON) out_printf("\"");
+			}
+			out_printf(format == FORMAT_JSON ? "]" : "'\n");
+		}
+	}
+	if (config_flags->show_ram && user_info->ram_total >= 0) {
+		format_number(format, &count, "ram_used", user_info->ram_used);
+		format_number(format, &count, "ram_total", user_info->ram_total);
+	}
+	if (config_flags->show_swap) {
+		format_number(format, &count, "swap_used", user_info->swap_used);
+		format_number(format, &count, "swap_total", user_info->swap_total);
+	}
+	if (config_flags->show_buff_cache)
+		format_number(format, &count, "buff_cache", user_info->buff_cache);
+	if (config_flags->show_hugepages) {
+		format_number(format, &count, "hugepages_used",
+					  user_info->hugepages_used);
+		format_number(format, &count, "hugepages_total",
+					  user_info->hugepages_total);
+	}
+	if (config_flags->show_resolution) {
+		format_key(format, &count, "resolution");
+		if (format == FORMAT_JSON) out_printf("[");
+		for (int i = 0; i < user_info->screen_count; i++)
+			out_printf(format == FORMAT_JSON
+						   ? "%s{\"width\": %d, \"height\": %d}"
+						   : "%s%dx%d",
+					   i ? (format == FORMAT_JSON ? ", " : ",") : "",
+					   user_info->screens[i].width,
+					   user_info->screens[i].height);
+		out_printf(format == FORMAT_JSON ? "]" : "\n");
+	}
+	if (config_flags->show_shell)
+		format_string(format, &count, "shell", user_info->shell);
+	if (config_flags->show_pkgs) {
+		format_number(format, &count, "pkgs", user_info->pkgs);
+		format_string(format, &count, "pkgman", user_info->pkgman_name);
+	}
+	if (config_flags->show_uptime)
+		format_number(format, &count, "uptime", get_uptime(user_info));
+	if (format == FORMAT_JSON) out_printf("\n}\n");
+	profile_end(start, "render");
+}
+
+// wraps a string of cap bytes, anything already in it is kept
+struct strbuf strbuf_wrap(char *data, size_t cap) {
+	struct strbuf buf = {data, strnlen(data, cap - 1), cap};
+	data[buf.len]	  = '\0';
+	return buf;
+}
+
+// returns -1 if the table could not grow, str is then left out
+int string_table_add(struct string_table *table, const char *str) {
+	size_t len = strlen(str) + 1;
+	if (table->size + len > table->cap) {
+		size_t cap = table->cap ? table->cap * 2 : 256;
+		while (cap < table->size + len) cap *= 2;
+		char *data = realloc(table->data, cap);
+		if (!data) return -1;
+		table->data = data;
+		table->cap	= cap;
+	}
+	memcpy(table->data + table->size, str, len);
+	table->size += len;
+	table->count++;
+	return 0;
+}
+
+// empties the table, the allocation is kept for the next strings
+void string_table_clear(struct string_table *table) {
+	table->size	 = 0;
+	table->count = 0;
+}
+
+// returns 0 if the memory could not be allocated
+int arena_init(struct arena *arena, size_t cap) {
+	arena->data = malloc(cap);
+	arena->size = 0;
+	arena->cap	= arena->data ? cap : 0;
+	pthread_mutex_init(&arena->lock, NULL);
+	return arena->data != NULL;
+}
+
+// returns where the len bytes of data were copied, or NULL if they do not fit
+char *arena_copy(struct arena *arena, const char *data, size_t len) {
+	char *copy = NULL;
+	pthread_mutex_lock(&arena->lock);
+	if (len <= arena->cap - arena->size) {
+		copy = arena->data + arena->size;
+		arena->size += len;
+	}
+	pthread_mutex_unlock(&arena->lock);
+	if (copy) memcpy(copy, data, len);
+	return copy;
+}
+
+// a string that does not fit is left out and the empty string is returned
+const char *arena_add(struct arena *arena, const char *str) {
+	const char *copy = arena_copy(arena, str, strlen(str) + 1);
+	return copy ? copy : "";
+}
+
+// returns 0 if the arena could not be allocated, every string starts empty
+int init_info(struct info *user_info) {
+#define INFO_STRING_INIT(field) user_info->field = "";
+	INFO_STRINGS(INFO_STRING_INIT)
+#undef INFO_STRING_INIT
+	return arena_init(&user_info->strings, ARENA_SIZE);
+}
+
+// the arena only grows, this moves the strings still in use to its start
+void compact_info(struct info *user_info) {
+	size_t size = 0;
+#define INFO_STRING_SIZE(field) size += strlen(user_info->field) + 1;
+	INFO_STRINGS(INFO_STRING_SIZE)
+#undef INFO_STRING_SIZE
+	char *copy = malloc(size), *end = copy;
+	if (!copy) return;
+#define INFO_STRING_SAVE(field)        \
+	strcpy(end, user_info->field);     \
+	user_info->field = end;            \
+	end += strlen(end) + 1;
+	INFO_STRINGS(INFO_STRING_SAVE)
+#undef INFO_STRING_SAVE
+	user_info->strings.size = 0;
+#define INFO_STRING_ADD(field) \
+	user_info->field = arena_add(&user_info->strings, user_info->field);
+	INFO_STRINGS(INFO_STRING_ADD)
+#undef INFO_STRING_ADD
+	free(copy);
+}
+
+void free_info(struct info *user_info) {
+	free(user_info->strings.data);
+	free(user_info->gpu_model.data);
+}
+
+// returns -1 if str had to be cut
+int strbuf_append(struct strbuf *buf, const char *str, size_t len) {
+	return strbuf_replace(buf, buf->len, 0, str, len);
+}
+
+/*
+ Replaces len bytes at start with with_len bytes of with. The rewrite happens
+in place, the tail only moves when the sizes differ and a longer replacement
+pushes it out of the buffer before with itself gets cut.
+ Returns -1 if anything had to be cut.
+*/
+int strbuf_replace(struct strbuf *buf, size_t start, size_t len,
+				   const char *with, size_t with_len) {
+	size_t room = buf->cap - 1, cut = 0;
+	if (start > buf->len) start = buf->len;
+	if (len > buf->len - start) len = buf->len - start;
+	size_t tail = buf->len - start - len;
+	if (with_len > room - start) {
+		cut		 = with_len - (room - start);
+		with_len = room - start;
+	}
+	if (start + with_len + tail > room) {
+		cut += start + with_len + tail - room;
+		tail = room - start - with_len;
+	}
+	if (with_len != len)
+		memmove(buf->data + start + with_len, buf->data + start + len, tail);
+	memcpy(buf->data + start, with, with_len);
+	buf->len			= start + with_len + tail;
+	buf->data[buf->len] = '\0';
+	return cut ? -1 : 0;
+}
+
+// returns -1 if the text had to be cut
+int strbuf_vprintf(struct strbuf *buf, const char *format, va_list args) {
+	int len = vsnprintf(buf->data + buf->len, buf->cap - buf->len, format, args);
+	if (len < 0) return -1;
+	if ((size_t)len < buf->cap - buf->len) {
+		buf->len += len;
+		return 0;
+	}
+	buf->len = buf->cap - 1;
+	return -1;
+}
+
+int strbuf_printf(struct strbuf *buf, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	int cut = strbuf_vprintf(buf, format, args);
+	va_end(args);
+	return cut;
+}
+
+// returns where the formatted text starts in the output buffer
+size_t out_vprintf(const char *format, va_list args) {
+	va_list retry;
+	va_copy(retry, args);
+	struct strbuf *buf = &output->buf;
+	size_t start	   = buf->len;
+	if (strbuf_vprintf(buf, format, args) < 0) {
+		if (start && output->flush) {
+			buf->len = start; // only a huge frame gets here
+			flush_output();
+			start = 0;
+		}
+		// what does not fit is cut
+		if (strbuf_vprintf(buf, format, retry) < 0) output->cut = 1;
+	}
+	va_end(retry);
+	return start;
+}
+
+void out_printf(const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	out_vprintf(format, args);
+	va_end(args);
+}
+
+// prints a line cut at width bytes, a negative width means no limit
+void out_line(int width, const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	size_t start = out_vprintf(format, args);
+	va_end(args);
+	if (width >= 0 && output->buf.len - start > (size_t)width)
+		output->buf.len = start + width;
+	out_printf("\n");
+}
+
+void out_write(const char *data, size_t len) {
+	struct strbuf *buf = &output->buf;
+	while (len > 0) {
+		if (buf->len == buf->cap - 1) {
+			if (!output->flush) {
+				output->cut = 1;
+				return;
+			}
+			flush_output();
+		}
+		size_t chunk =
+			buf->cap - 1 - buf->len < len ? buf->cap - 1 - buf->len : len;
+		strbuf_append(buf, data, chunk);
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+// the frame of uwu_render() stays in its buffer
+void flush_output(void) {
+	if (!output->flush) return;
+	long start = profile_begin();
+	fflush(stdout); // in case something was printed with printf
+	struct strbuf *buf = &output->buf;
+	size_t written	   = 0;
+	while (written < buf->len) {
+#ifndef _WIN32
+		ssize_t bytes =
+			write(STDOUT_FILENO, buf->data + written, buf->len - written);
+		if (bytes < 0 && errno == EINTR) continue;
+#else  // _WIN32
+		long bytes = fwrite(buf->data + written, 1, buf->len - written, stdout);
+		fflush(stdout);
+#endif // _WIN32
+		if (bytes <= 0) break;
+		written += bytes;
+	}
+	buf->len = 0;
+	profile_end(start, "write");
+}
+
+// FNV-1a, 64 bits wide because fingerprints are only compared
+uint64_t fingerprint_hash(uint64_t hash, const void *data, size_t len) {
+	for (size_t i = 0; i < len; i++)
+		hash = (hash ^ ((const unsigned char *)data)[i]) * 1099511628211u;
+	return hash;
+}
+
+// changes when any of the files is modified, replaced, created or removed
+uint64_t fingerprint_files(const char **paths) {
+	uint64_t hash = 14695981039346656037u;
+	for (int i = 0; paths[i]; i++) {
+		struct stat st;
+		long long values[3] = {0};
+		char buf[1024];
+		if (stat(root_path(paths[i], buf, sizeof(buf)), &st) == 0) {
+			values[0] = st.st_ino;
+			values[1] = st.st_mtime;
+			values[2] = st.st_size;
+		}
+		hash = fingerprint_hash(hash, paths[i], strlen(paths[i]));
+		hash = fingerprint_hash(hash, values, sizeof(values));
+	}
+	return hash;
+}
+
+uint64_t fingerprint_os(void) {
+	const char *paths[] = {"/etc/os-release", NULL};
+	return fingerprint_files(paths);
+}
+
+#ifndef _WIN32
+// the kernel fingerprint and collector share a single uname() call, the
+// kernel cannot change while uwufetch runs
+struct utsname uname_result;
+pthread_once_t uname_once = PTHREAD_ONCE_INIT;
+
+void call_uname(void) { uname(&uname_result); } // left empty if it fails
+
+const struct utsname *system_uname(void) {
+	pthread_once(&uname_once, call_uname);
+	return &uname_result;
+}
+#endif // _WIN32
+
+uint64_t fingerprint_kernel(void) {
+	uint64_t hash = 14695981039346656037u;
+#ifndef _WIN32
+	const struct utsname *sys_var = system_uname();
+	hash = fingerprint_hash(hash, sys_var->sysname, strlen(sys_var->sysname));
+	hash = fingerprint_hash(hash, sys_var->release, strlen(sys_var->release));
+	hash = fingerprint_hash(hash, sys_var->machine, strlen(sys_var->machine));
+#endif // _WIN32
+	return hash;
+}
+
+uint64_t fingerprint_pkgs(void) { // the databases read by pkgman()
+	const char *paths[] = {"/var/lib/dpkg/status",
+						   "/lib/apk/db/installed",
+						   "/var/db/pkg",
+						   "/var/lib/pacman/local",
+						   "/var/db/xbps/pkgdb-0.38.plist",
+						   "/var/lib/rpm",
+						   "/var/lib/flatpak/app",
+						   "/var/lib/flatpak/runtime",
+						   "/snap",
+						   "/var/lib/snapd/snap",
+						   "/nix/var/nix/profiles",
+						   "/var/guix/profiles",
+						   NULL};
+	return fingerprint_files(paths);
+}
+
+uint64_t fingerprint_gpu(void) { // cards and connectors known to DRM
+	uint64_t hash = 14695981039346656037u;
+	DIR *dir	  = root_opendir("/sys/class/drm");
+	if (!dir) return hash;
+	struct dirent *entry;
+	while ((entry = readdir(dir))) // summed, readdir order is not stable
+		hash += fingerprint_hash(14695981039346656037u, entry->d_name,
+								 strlen(entry->d_name));
+	closedir(dir);
+	return hash;
+}
+
+/*
+ The status and preferred mode of every connector, what read_drm_screens()
+shows, so that plugging a monitor collects the resolution again. Without DRM
+the display server could only be checked by asking it, which is what the
+collector does, so the fingerprint then changes every minute instead.
+*/
+uint64_t fingerprint_resolution(void) {
+	uint64_t hash = 14695981039346656037u;
+	int connectors = 0;
+#ifdef __linux__ // the only system where read_drm_screens() is used
+	DIR *dir = root_opendir("/sys/class/drm");
+	struct dirent *entry;
+	while (dir && (entry = readdir(dir))) {
+		char connector[sizeof("/sys/class/drm/") + 256], status[32] = "",
+			 modes[64] = "";
+		if (strncmp(entry->d_name, "card", 4) != 0 ||
+			!strchr(entry->d_name, '-') ||
+			snprintf(connector, sizeof(connector), "/sys/class/drm/%s",
+					 entry->d_name) >= (int)sizeof(connector))
+			continue;
+		read_sysfs_line(connector, "status", status, sizeof(status));
+		read_sysfs_line(connector, "modes", modes, sizeof(modes));
+		uint64_t connector_hash = fingerprint_hash(
+			14695981039346656037u, entry->d_name, strlen(entry->d_name));
+		connector_hash = fingerprint_hash(connector_hash, status, strlen(status));
+		connector_hash = fingerprint_hash(connector_hash, modes, strlen(modes));
+		hash += connector_hash; // summed, readdir order is not stable
+		connectors++;
+	}
+	if (dir) closedir(dir);
+#endif // __linux__
+	if (connectors == 0) {
+		int64_t minute = time(NULL) / 60;
+		hash		   = fingerprint_hash(hash, &minute, sizeof(minute));
+	}
+	return hash;
+}
+
+struct {
+	int fields; // depending on the source
+	uint64_t (*compute)(void);
+} fingerprint_sources[FINGERPRINT_COUNT] = {
+	[FINGERPRINT_OS]	 = {FIELD_OS, fingerprint_os},
+	[FINGERPRINT_KERNEL] = {FIELD_KERNEL, fingerprint_kernel},
+	[FINGERPRINT_PKGS]	 = {FIELD_PKGS, fingerprint_pkgs},
+	[FINGERPRINT_GPU]	 = {FIELD_GPU, fingerprint_gpu},
+	[FINGERPRINT_RESOLUTION] = {FIELD_RESOLUTION, fingerprint_resolution}};
+
+// only the sources of the fields that are going to be collected are updated
+void compute_fingerprints(uint64_t *fingerprints, int fields) {
+	for (int i = 0; i < FINGERPRINT_COUNT; i++)
+		if (fields & fingerprint_sources[i].fields)
+			fingerprints[i] = fingerprint_sources[i].compute();
+}
+
+// the fields that are shown, the os is always needed for the logo and by the
+// other collectors
+int enabled_fields(struct configuration *config_flags) {
+	int fields = FIELD_OS;
+	if (config_flags->show_user_info || config_flags->show_shell)
+		fields |= FIELD_USER;
+	if (config_flags->show_host) fields |= FIELD_HOST;
+	if (config_flags->show_cpu) fields |= FIELD_CPU;
+	if (config_flags->show_kernel) fields |= FIELD_KERNEL;
+	if (config_flags->show_ram || config_flags->show_swap ||
+		config_flags->show_buff_cache || config_flags->show_hugepages)
+		fields |= FIELD_RAM;
+	if (config_flags->show_gpu) fields |= FIELD_GPU;
+	if (config_flags->show_resolution) fields |= FIELD_RESOLUTION;
+	if (config_flags->show_pkgs) fields |= FIELD_PKGS;
+	return fields;
+}
+
+// shows the lines of the given fields and hides the others, the uptime, the
+// colors and the extra memory lines are not changed
+void show_fields(struct configuration *config_flags, int fields) {
+	config_flags->show_os		  = (fields & FIELD_OS) != 0;
+	config_flags->show_user_info  = (fields & FIELD_USER) != 0;
+	config_flags->show_shell	  = (fields & FIELD_USER) != 0;
+	config_flags->show_host		  = (fields & FIELD_HOST) != 0;
+	config_flags->show_cpu		  = (fields & FIELD_CPU) != 0;
+	config_flags->show_kernel	  = (fields & FIELD_KERNEL) != 0;
+	config_flags->show_ram		  = (fields & FIELD_RAM) != 0;
+	config_flags->show_gpu		  = (fields & FIELD_GPU) != 0;
+	config_flags->show_resolution = (fields & FIELD_RESOLUTION) != 0;
+	config_flags->show_pkgs		  = (fields & FIELD_PKGS) != 0;
+}
+
+// returns the enabled fields of the cache that have to be collected again,
+// because they were never collected, their ttl expired or their source changed
+int stale_fields(struct configuration *config_flags, struct info *user_info) {
+	uint64_t current[FINGERPRINT_COUNT];
+	int fields = 0;
+	compute_fingerprints(current, FIELD_ALL);
+	for (int i = 0; i < FINGERPRINT_COUNT; i++)
+		if (current[i] != user_info->fingerprints[i])
+			fields |= fingerprint_sources[i].fields;
+	int64_t now = time(NULL);
+	for (int i = 0; i < FIELD_COUNT; i++)
+		if (user_info->collected[i] == 0 ||
+			(config_flags->cache_ttl[i] != CACHE_FOREVER &&
+			 now - user_info->collected[i] >= config_flags->cache_ttl[i]))
+			fields |= 1 << i;
+	return fields & enabled_fields(config_flags);
+}
+
+#ifdef __linux__
+/*
+ Fills the memory values from /proc/meminfo, without running free. Used
+memory follows the MemAvailable semantics of free: what could be given to a
+new program without swapping is not counted as used.
+*/
+void read_meminfo(struct info *user_info) {
+	char buffer[8192], *line, *save = NULL;
+	ssize_t len = -1;
+	int fd		= root_open("/proc/meminfo", O_RDONLY);
+	if (fd >= 0) {
+		len = read(fd, buffer, sizeof(buffer) - 1);
+		close(fd);
+	}
+	if (len <= 0) { // no procfs, sysinfo() has no MemAvailable
+		sysinfo(&user_info->sys);
+		unsigned long unit =
+			user_info->sys.mem_unit ? user_info->sys.mem_unit : 1;
+		user_info->ram_total = user_info->sys.totalram * unit / 1048576;
+		user_info->ram_used	 = (user_info->sys.totalram -
+								user_info->sys.freeram -
+								user_info->sys.bufferram) *
+							   unit / 1048576;
+		user_info->buff_cache = user_info->sys.bufferram * unit / 1048576;
+		user_info->swap_total = user_info->sys.totalswap * unit / 1048576;
+		user_info->swap_used = (user_info->sys.totalswap -
+								user_info->sys.freeswap) *
+							   unit / 1048576;
+		return;
+	}
+	buffer[len] = '\0';
+
+	// values in kB, except for the huge pages counts
+	unsigned long total = 0, mem_free = 0, available = 0, buffers = 0,
+				  cached = 0, reclaimable = 0, swap_total = 0, swap_free = 0,
+				  huge_total = 0, huge_free = 0, huge_size = 0;
+	struct {
+		char *name;
+		unsigned long *value;
+	} fields[] = {{"MemTotal", &total},
+				  {"MemFree", &mem_free},
+				  {"MemAvailable", &available},
+				  {"Buffers", &buffers},
+				  {"Cached", &cached},
+				  {"SReclaimable", &reclaimable},
+				  {"SwapTotal", &swap_total},
+				  {"SwapFree", &swap_free},
+				  {"HugePages_Total", &huge_total},
+				  {"HugePages_Free", &huge_free},
+				  {"Hugepagesize", &huge_size}};
+	for (line = strtok_r(buffer, "\n", &save); line;
+		 line = strtok_r(NULL, "\n", &save)) {
+		char *colon = strchr(line, ':');
+		if (!colon) continue;
+		*colon = '\0';
+		for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+			if (strcmp(line, fields[i].name) == 0) {
+				*fields[i].value = strtoul(colon + 1, NULL, 10);
+				break;
+			}
+	}
+	if (available == 0) // kernels older than 3.14
+		available = mem_free + buffers + cached + reclaimable;
+
+	user_info->ram_total	   = total / 1024;
+	user_info->ram_used		   = (total - available) / 1024;
+	user_info->buff_cache	   = (buffers + cached + reclaimable) / 1024;
+	user_info->swap_total	   = swap_total / 1024;
+	user_info->swap_used	   = (swap_total - swap_free) / 1024;
+	user_info->hugepages_total = huge_total * huge_size / 1024;
+	user_info->hugepages_used  = (huge_total - huge_free) * huge_size / 1024;
+}
+#endif // __linux__
+
+#ifdef __linux__
+	#ifndef PCI_DEVICES_DIR
+		#define PCI_DEVICES_DIR "/sys/bus/pci/devices"
+	#endif
+	#ifndef PCI_IDS_PATHS
+		#define PCI_IDS_PATHS \
+			"/usr/share/hwdata/pci.ids", "/usr/share/misc/pci.ids", \
+				"/usr/share/pci.ids"
+	#endif
+	#define PCI_IDS_MAGIC 0x31444955 // "UID1", bump when the layout changes
+
+struct pci_ids_entry {
+	uint32_t id;	 // vendor, or vendor << 16 | device
+	uint32_t offset; // of the name in pci.ids
+};
+
+// sorted index of pci.ids, cached in ~/.cache/uwufetch.pciids
+struct pci_ids_index {
+	uint32_t magic, vendor_count, device_count, unused;
+	int64_t ids_mtime, ids_size;	// of the pci.ids it was built from
+	struct pci_ids_entry entries[]; // vendors first, then devices
+};
+
+struct pci_ids {
+	char *ids; // the mapped pci.ids
+	size_t ids_size, index_size;
+	struct pci_ids_index *index;
+};
+
+int compare_pci_ids(const void *a, const void *b) {
+	uint32_t id_a = ((const struct pci_ids_entry *)a)->id,
+			 id_b = ((const struct pci_ids_entry *)b)->id;
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+// returns the value of 4 hex digits, or -1
+int parse_hex4(const char *str) {
+	int value = 0;
+	for (int i = 0; i < 4; i++) {
+		char c = str[i];
+		if (c >= '0' && c <= '9')
+			value = value * 16 + c - '0';
+		else if (c >= 'a' && c <= 'f')
+			value = value * 16 + c - 'a' + 10;
+		else
+			return -1;
+	}
+	return value;
+}
+
+// indexes the vendor ("vvvv  name") and device ("\tdddd  name") lines
+struct pci_ids_index *build_pci_ids_index(struct pci_ids *pci,
+										  struct stat *ids_stat) {
+	char *end	 = pci->ids + pci->ids_size;
+	size_t lines = 1;
+	for (char *c = pci->ids; (c = memchr(c, '\n', end - c)); c++) lines++;
+	struct pci_ids_entry *vendors = malloc(lines * sizeof(*vendors)),
+						 *devices = malloc(lines * sizeof(*devices));
+	uint32_t vendor_count = 0, device_count = 0;
+	int vendor			  = -1;
+	for (char *line = pci->ids, *next; vendors && devices && line < end;
+		 line = next) {
+		next = memchr(line, '\n', end - line);
+		next = next ? next + 1 : end;
+		if (next - line < 8) continue;
+		if (line[0] == 'C' && line[1] == ' ') break; // device classes follow
+		if (line[0] != '\t' && (vendor = parse_hex4(line)) >= 0)
+			vendors[vendor_count++] =
+				(struct pci_ids_entry){vendor, line + 6 - pci->ids};
+		else if (line[0] == '\t' && line[1] != '\t' && vendor >= 0) {
+			int device = parse_hex4(line + 1);
+			if (device >= 0)
+				devices[device_count++] = (struct pci_ids_entry){
+					(uint32_t)vendor << 16 | device, line + 7 - pci->ids};
+		}
+	}
+	struct pci_ids_index *index = NULL;
+	if (vendors && devices) {
+		qsort(vendors, vendor_count, sizeof(*vendors), compare_pci_ids);
+		qsort(devices, device_count, sizeof(*devices), compare_pci_ids);
+		pci->index_size = sizeof(*index) +
+						  (vendor_count + device_count) * sizeof(*vendors);
+		index = malloc(pci->index_size);
+	}
+	if (index) {
+		*index = (struct pci_ids_index){PCI_IDS_MAGIC,		vendor_count,
+										device_count,		0,
+										ids_stat->st_mtime, ids_stat->st_size};
+		memcpy(index->entries, vendors, vendor_count * sizeof(*vendors));
+		memcpy(index->entries + vendor_count, devices,
+			   device_count * sizeof(*devices));
+	}
+	free(vendors);
+	free(devices);
+	return index;
+}
+
+// maps pci.ids and its index, the index is built and saved on first use
+int open_pci_ids(struct pci_ids *pci) {
+	const char *ids_paths[] = {PCI_IDS_PATHS};
+	struct stat ids_stat;
+	int fd = -1;
+	for (size_t i = 0; fd < 0 && i < sizeof(ids_paths) / sizeof(ids_paths[0]);
+		 i++)
+		fd = root_open(ids_paths[i], O_RDONLY);
+	if (fd < 0) return 0;
+	if (fstat(fd, &ids_stat) != 0 || ids_stat.st_size == 0) {
+		close(fd);
+		return 0;
+	}
+	pci->ids_size = ids_stat.st_size;
+	pci->ids	  = mmap(NULL, pci->ids_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pci->ids == MAP_FAILED) return 0;
+
+	char index_file[512] = "";
+	if (getenv("HOME")) {
+		sprintf(index_file, "%s/.cache/uwufetch.pciids", getenv("HOME"));
+		struct stat index_stat;
+		fd = open(index_file, O_RDONLY);
+		if (fd >= 0 && fstat(fd, &index_stat) == 0 &&
+			(size_t)index_stat.st_size >= sizeof(struct pci_ids_index)) {
+			pci->index_size = index_stat.st_size;
+			pci->index		= mmap(NULL, pci->index_size, PROT_READ,
+								   MAP_PRIVATE, fd, 0);
+			if (pci->index == MAP_FAILED)
+				pci->index = NULL;
+			else if (pci->index->magic != PCI_IDS_MAGIC ||
+					 pci->index->ids_mtime != ids_stat.st_mtime ||
+					 pci->index->ids_size != ids_stat.st_size ||
+					 pci->index_size != sizeof(struct pci_ids_index) +
+											(pci->index->vendor_count +
+											 pci->index->device_count) *
+												sizeof(struct pci_ids_entry)) {
+				munmap(pci->index, pci->index_size); // pci.ids was updated
+				pci->index = NULL;
+			}
+		}
+		if (fd >= 0) close(fd);
+	}
+	if (pci->index) return 1;
+
+	pci->index = build_pci_ids_index(pci, &ids_stat);
+	if (!pci->index) {
+		munmap(pci->ids, pci->ids_size);
+		return 0;
+	}
+	if (index_file[0]) { // written with a rename, another run could read it
+		char temp_file[600];
+		sprintf(temp_file, "%s.%d", index_file, (int)getpid());
+		FILE *index_fp = fopen(temp_file, "w");
+		if (index_fp) {
+			int written = fwrite(pci->index, pci->index_size, 1, index_fp) == 1;
+			if (fclose(index_fp) == 0 && written)
+				rename(temp_file, index_file);
+			else
+				unlink(temp_file);
+		}
+	}
+	return 1;
+}
+
+// pci.ids and its index stay mapped for the whole process, a program using
+// libuwufetch looks up the gpus on every uwu_collect()
+struct pci_ids pci_ids;
+int pci_ids_opened;
+pthread_once_t pci_ids_once = PTHREAD_ONCE_INIT;
+
+void load_pci_ids(void) { pci_ids_opened = open_pci_ids(&pci_ids); }
+
+// name of a vendor (device < 0) or of a device, NULL when unknown
+char *pci_ids_name(struct pci_ids *pci, int vendor, int device, int *len) {
+	struct pci_ids_entry key = {device < 0 ? (uint32_t)vendor
+										   : (uint32_t)vendor << 16 | device,
+								0},
+						 *found;
+	if (device < 0)
+		found = bsearch(&key, pci->index->entries, pci->index->vendor_count,
+						sizeof(key), compare_pci_ids);
+	else
+		found = bsearch(&key, pci->index->entries + pci->index->vendor_count,
+						pci->index->device_count, sizeof(key), compare_pci_ids);
+	if (!found || found->offset >= pci->ids_size) return NULL;
+	char *name = pci->ids + found->offset,
+		 *end  = memchr(name, '\n', pci->ids + pci->ids_size - name);
+	*len	   = end ? end - name : pci->ids + pci->ids_size - name;
+	return name;
+}
+
+// reads the first line of a sysfs attribute, returns 0 if it is empty
+int read_sysfs_line(const char *dir, const char *attribute, char *value,
+					size_t size) {
+	char path[512];
+	snprintf(path, sizeof(path), "%s/%s", dir, attribute);
+	int fd = root_open(path, O_RDONLY);
+	if (fd < 0) return 0;
+	ssize_t len = read(fd, value, size - 1);
+	close(fd);
+	if (len <= 0) return 0;
+	value[len] = '\0';
+	value[strcspn(value, "\n")] = '\0';
+	return value[0] != '\0';
+}
+
+// reads a sysfs attribute like "0x030000"
+long read_sysfs_hex(const char *dir, const char *attribute) {
+	char value[32];
+	if (!read_sysfs_line(dir, attribute, value, sizeof(value))) return -1;
+	return strtol(value, NULL, 16);
+}
+
+// finds the display controllers on the pci bus without running lshw or lspci,
+// returns how many were found, -1 when there is no pci bus in sysfs
+int read_pci_gpus(struct info *user_info) {
+	DIR *devices = root_opendir(PCI_DEVICES_DIR);
+	if (!devices) return -1;
+	int has_ids = -1; // pci.ids is opened only if a gpu is found
+	int gpun	= 0;
+	struct dirent *entry;
+	while ((entry = readdir(devices))) {
+		if (entry->d_name[0] == '.') continue;
+		char device_dir[512];
+		snprintf(device_dir, sizeof(device_dir), PCI_DEVICES_DIR "/%s",
+				 entry->d_name);
+		if (read_sysfs_hex(device_dir, "class") >> 16 != 0x03) continue;
+		long vendor = read_sysfs_hex(device_dir, "vendor"),
+			 device = read_sysfs_hex(device_dir, "device");
+		if (vendor < 0 || device < 0) continue;
+		if (has_ids < 0) {
+			pthread_once(&pci_ids_once, load_pci_ids);
+			has_ids = pci_ids_opened;
+		}
+
+		// same format as lspci -mm: "<vendor> <device>"
+		char *vendor_name = NULL, *device_name = NULL;
+		int vendor_len = 0, device_len = 0;
+		if (has_ids) {
+			vendor_name = pci_ids_name(&pci_ids, vendor, -1, &vendor_len);
+			device_name = pci_ids_name(&pci_ids, vendor, device, &device_len);
+		}
+		char gpu[256];
+		if (vendor_name)
+			snprintf(gpu, sizeof(gpu), "%.*s ", vendor_len, vendor_name);
+		else
+			snprintf(gpu, sizeof(gpu), "Vendor %04lx ", vendor);
+		if (device_name)
+			snprintf(gpu + strlen(gpu), sizeof(gpu) - strlen(gpu), "%.*s",
+					 device_len, device_name);
+		else
+			snprintf(gpu + strlen(gpu), sizeof(gpu) - strlen(gpu),
+					 "Device %04lx", device);
+		add_gpu(user_info, gpu, sizeof(gpu));
+		gpun++;
+	}
+	closedir(devices);
+	return gpun;
+}
+
+int compare_names(const void *a, const void *b) { return strcmp(a, b); }
+
+/*
+ Reads the connected monitors of every card from its connectors in
+/sys/class/drm, sorted by name because readdir() order is not stable. The
+mode in use is not in sysfs, the first one of the modes file is the preferred
+mode of the monitor, which is what it runs at unless it was changed.
+Returns -1 when there are no connectors, 0 on a headless machine.
+*/
+int read_drm_screens(struct info *user_info) {
+	DIR *dir = root_opendir("/sys/class/drm");
+	if (!dir) return -1;
+	char names[32][64]; // card0-DP-1, card0-HDMI-A-1, ...
+	int name_count = 0;
+	struct dirent *entry;
+	while ((entry = readdir(dir)) && name_count < 32) {
+		size_t len = strlen(entry->d_name);
+		// a longer name would be cut, and then not be found
+		if (strncmp(entry->d_name, "card", 4) == 0 &&
+			strchr(entry->d_name, '-') && len < sizeof(names[0]))
+			memcpy(names[name_count++], entry->d_name, len + 1);
+	}
+	closedir(dir);
+	if (name_count == 0) return -1;
+	qsort(names, name_count, sizeof(names[0]), compare_names);
+
+	for (int i = 0; i < name_count && user_info->screen_count < MAX_SCREENS;
+		 i++) {
+		char connector[sizeof("/sys/class/drm/") + sizeof(names[0])], value[64];
+		struct screen *screen = &user_info->screens[user_info->screen_count];
+		if (snprintf(connector, sizeof(connector), "/sys/class/drm/%.*s",
+					 (int)sizeof(names[0]) - 1,
+					 names[i]) >= (int)sizeof(connector))
+			continue;
+		if (read_sysfs_line(connector, "status", value, sizeof(value)) &&
+			strcmp(value, "connected") == 0 &&
+			read_sysfs_line(connector, "modes", value, sizeof(value)) &&
+			sscanf(value, "%dx%d", &screen->width, &screen->height) == 2)
+			user_info->screen_count++;
+	}
+	return user_info->screen_count;
+}
+
+#define MAX_CPUS 4096
+#define CPU_BIT_SET(bits, cpu) ((bits)[(cpu) / 8] |= 1 << (cpu) % 8)
+#define CPU_BIT_ISSET(bits, cpu) ((bits)[(cpu) / 8] & 1 << (cpu) % 8)
+
+// marks the cpus of a list like "0-3,8-11", returns how many there are
+int parse_cpu_list(const char *list, unsigned char *bits) {
+	int count = 0;
+	while (*list) {
+		char *end;
+		long first = strtol(list, &end, 10), last = first;
+		if (end == list) break;
+		if (*end == '-') last = strtol(end + 1, &end, 10);
+		for (long cpu = first; cpu <= last && cpu < MAX_CPUS; cpu++) {
+			if (!CPU_BIT_ISSET(bits, cpu)) count++;
+			CPU_BIT_SET(bits, cpu);
+		}
+		list = end + (*end == ',');
+		if (*end != ',') break;
+	}
+	return count;
+}
+
+/*
+ Counts the sockets, cores and threads of the online cpus in
+/sys/devices/system/cpu. The siblings of every cpu that is read are marked as
+seen, so there is one read per core and per socket instead of one per thread.
+The newer names of the lists are tried first, the older ones are still there
+on every kernel.
+*/
+int read_cpu_topology(struct cpu_topology *topology) {
+	unsigned char online[MAX_CPUS / 8] = {0}, core_seen[MAX_CPUS / 8] = {0},
+				  socket_seen[MAX_CPUS / 8] = {0};
+	char list[1024];
+	if (!read_sysfs_line("/sys/devices/system/cpu", "online", list,
+						 sizeof(list)))
+		return 0;
+	topology->threads = parse_cpu_list(list, online);
+	int first_cpu	  = -1;
+	for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+		if (!CPU_BIT_ISSET(online, cpu)) continue;
+		if (first_cpu < 0) first_cpu = cpu;
+		char dir[64];
+		snprintf(dir, sizeof(dir), "/sys/devices/system/cpu/cpu%d/topology",
+				 cpu);
+		if (!CPU_BIT_ISSET(core_seen, cpu)) {
+			topology->cores++;
+			if (read_sysfs_line(dir, "core_cpus_list", list, sizeof(list)) ||
+				read_sysfs_line(dir, "thread_siblings_list", list,
+								sizeof(list)))
+				parse_cpu_list(list, core_seen);
+			CPU_BIT_SET(core_seen, cpu);
+		}
+		if (!CPU_BIT_ISSET(socket_seen, cpu)) {
+			topology->sockets++;
+			if (read_sysfs_line(dir, "package_cpus_list", list, sizeof(list)) ||
+				read_sysfs_line(dir, "core_siblings_list", list, sizeof(list)))
+				parse_cpu_list(list, socket_seen);
+			CPU_BIT_SET(socket_seen, cpu);
+		}
+	}
+	// hybrid cpus have faster cores, but the first one is one of them
+	char dir[64], khz[32];
+	snprintf(dir, sizeof(dir), "/sys/devices/system/cpu/cpu%d/cpufreq",
+			 first_cpu);
+	if (read_sysfs_line(dir, "cpuinfo_max_freq", khz, sizeof(khz)))
+		topology->max_khz = atol(khz);
+	return topology->threads;
+}
+#endif // __linux__
+
+#ifndef _WIN32
+// XRRMonitorInfo of <X11/extensions/Xrandr.h>
+struct xrr_monitor {
+	unsigned long name;
+	int primary, automatic, output_count, x, y, width, height, mm_width,
+		mm_height;
+	unsigned long *outputs;
+};
+
+/*
+ Asks the X server (XWayland too) for its monitors through libX11 and
+libXrandr, loaded with dlopen() so that uwufetch does not depend on them.
+Without RandR the size of the root window is used, like xwininfo -root did.
+*/
+int query_x11_screens(struct info *user_info) {
+	void *x11 = dlopen("libX11.so.6", RTLD_LAZY | RTLD_LOCAL);
+	if (!x11) x11 = dlopen("libX11.6.dylib", RTLD_LAZY | RTLD_LOCAL);
+	if (!x11) return 0;
+	void *(*open_display)(const char *) = dlsym(x11, "XOpenDisplay");
+	int (*close_display)(void *)		= dlsym(x11, "XCloseDisplay");
+	unsigned long (*root_window)(void *) = dlsym(x11, "XDefaultRootWindow");
+	int (*default_screen)(void *)		 = dlsym(x11, "XDefaultScreen");
+	int (*display_width)(void *, int)	 = dlsym(x11, "XDisplayWidth");
+	int (*display_height)(void *, int)	 = dlsym(x11, "XDisplayHeight");
+	void *display						 = NULL;
+	if (open_display && close_display && root_window && default_screen &&
+		display_width && display_height)
+		display = open_display(NULL);
+	if (!display) {
+		dlclose(x11);
+		return 0;
+	}
+
+	void *xrandr = dlopen("libXrandr.so.2", RTLD_LAZY | RTLD_LOCAL);
+	if (!xrandr) xrandr = dlopen("libXrandr.2.dylib", RTLD_LAZY | RTLD_LOCAL);
+	if (xrandr) {
+		struct xrr_monitor *(*get_monitors)(void *, unsigned long, int, int *) =
+			dlsym(xrandr, "XRRGetMonitors");
+		void (*free_monitors)(struct xrr_monitor *) =
+			dlsym(xrandr, "XRRFreeMonitors");
+		int count					= 0;
+		struct xrr_monitor *monitors = NULL;
+		if (get_monitors && free_monitors)
+			monitors = get_monitors(display, root_window(display), 1, &count);
+		for (int i = 0; monitors && i < count && i < MAX_SCREENS; i++)
+			user_info->screens[user_info->screen_count++] =
+				(struct screen){monitors[i].width, monitors[i].height};
+		if (monitors) free_monitors(monitors);
+		dlclose(xrandr);
+	}
+	if (user_info->screen_count == 0) {
+		int screen = default_screen(display);
+		user_info->screens[user_info->screen_count++] = (struct screen){
+			display_width(display, screen), display_height(display, screen)};
+	}
+	close_display(display);
+	dlclose(x11);
+	return user_info->screen_count;
+}
+
+// the child of read_x11_screens(), prints "<width> <height>" for every screen
+void print_x11_screens(void *user_info) {
+	struct info *info = user_info; // a copy, this is another process
+	info->screen_count = 0;
+	int count		   = query_x11_screens(info);
+	for (int i = 0; i < count; i++)
+		dprintf(STDOUT_FILENO, "%d %d\n", info->screens[i].width,
+				info->screens[i].height);
+}
+
+/*
+ XOpenDisplay() cannot be given a timeout, and a server that accepts the
+connection but never answers would block it, so the X server is asked from a
+child process that gets killed at the probe deadline.
+*/
+int read_x11_screens(struct info *user_info) {
+	if (!getenv("DISPLAY")) return 0;
+	FILE *screens = probe_fork(print_x11_screens, user_info);
+	if (!screens) return 0;
+	struct screen screen;
+	while (user_info->screen_count < MAX_SCREENS &&
+		   fscanf(screens, "%d %d", &screen.width, &screen.height) == 2)
+		user_info->screens[user_info->screen_count++] = screen;
+	probe_pclose(screens);
+	return user_info->screen_count;
+}
+#endif // _WIN32
+
+// collectors: every collector fills only its own fields of user_info, so
+// they can all run at the same time
+void collect_os(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+	char line[256], id[64]; // var to scan file lines
+#ifdef _WIN32
+	user_info->version_name = "windows";
+	return;
+#endif // _WIN32
+	FILE *os_release = root_fopen("/etc/os-release", "r");
+	if (os_release) { // get normal vars
+		while (fgets(line, sizeof(line), os_release))
+			if (sscanf(line, "\nID=\"%63s\"", id) ||
+				sscanf(line, "\nID=%63s", id)) {
+				user_info->version_name = arena_add(&user_info->strings, id);
+				break;
+			}
+		fclose(os_release);
+
+		// trying to detect amogos because in its os-release file ID value is
+		// just "debian"
+		if (strcmp(user_info->version_name, "debian") == 0 ||
+			strcmp(user_info->version_name, "raspbian") ==
+				0) // will be removed when amogos will have an os-release file
+				   // with ID=amogos
+		{
+			DIR *amogos_plymouth =
+				root_opendir("/usr/share/plymouth/themes/amogos");
+			if (amogos_plymouth) {
+				closedir(amogos_plymouth);
+				user_info->version_name = "amogos";
+			}
+		}
+	} else { // try for android vars, next for Apple var, or unknown system
+		DIR *system_app		 = root_opendir("/system/app/");
+		DIR *system_priv_app = root_opendir("/system/priv-app/");
+		DIR *library		 = root_opendir("/Library/");
+		if (system_app && system_priv_app) // android
+			user_info->version_name = "android";
+		else if (library) // Apple
+		{
+#ifdef __APPLE__
+	#ifndef TARGET_OS_IPHONE
+			user_info->version_name = "macos";
+	#else
+			user_info->version_name = "ios";
+	#endif
+#endif
+		} else
+			user_info->version_name = "unknown";
+		if (system_app) closedir(system_app);
+		if (system_priv_app) closedir(system_priv_app);
+		if (library) closedir(library);
+	}
+}
+
+void collect_user(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+#ifndef _WIN32
+	if (strcmp(user_info->version_name, "android") == 0) {
+		FILE *whoami = probe_popen("whoami");
+		if (!whoami)
+			user_info->user = TIMED_OUT;
+		else {
+			char user[128];
+			if (fscanf(whoami, "%127s", user) == 1)
+				user_info->user = arena_add(&user_info->strings, user);
+			probe_pclose(whoami);
+		}
+	} else {
+		char *tmp_user = getenv("USER");
+		user_info->user =
+			arena_add(&user_info->strings, tmp_user ? tmp_user : "");
+	}
+	char host[256] = "";
+	gethostname(host, sizeof(host) - 1);
+	user_info->host = arena_add(&user_info->strings, host);
+	char *tmp_shell = getenv("SHELL");
+	if (tmp_shell == NULL) tmp_shell = "";
+	if (strlen(tmp_shell) > 16) // android shell was too long, this works only
+								// for termux
+		tmp_shell = strlen(tmp_shell) > 27 ? tmp_shell + 27 : "";
+	user_info->shell = arena_add(&user_info->strings, tmp_shell);
+#else
+	char line[256], host[256], user[128];
+	FILE *user_host_fp = popen("wmic computersystem get username", "r");
+	while (fgets(line, sizeof(line), user_host_fp)) {
+		if (strstr(line, "UserName") != 0)
+			continue;
+		else {
+			if (sscanf(line, "%255[^\\]%127s", host, user) == 2) {
+				user_info->host = arena_add(&user_info->strings, host);
+				user_info->user = arena_add(&user_info->strings, user + 1);
+			}
+			break;
+		}
+	}
+	pclose(user_host_fp);
+	FILE *shell_fp = popen("powershell $PSVersionTable", "r");
+	char tmp_shell[64] = "", shell[128];
+	while (fgets(line, sizeof(line), shell_fp))
+		if (sscanf(line, "PSVersion                      %63s", tmp_shell) != 0)
+			break;
+	snprintf(shell, sizeof(shell), "PowerShell %s", tmp_shell);
+	user_info->shell = arena_add(&user_info->strings, shell);
+	pclose(shell_fp);
+#endif // _WIN32
+}
+
+void collect_host(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+	char line[256], model[256] = "";
+	FILE *host_model_info;
+	if (strcmp(user_info->version_name, "android") == 0) {
+		host_model_info = probe_popen("getprop ro.product.model");
+		if (!host_model_info) {
+			user_info->host_model = TIMED_OUT;
+			return;
+		}
+		while (fgets(line, sizeof(line), host_model_info))
+			if (sscanf(line, "%[^\n]", model)) break;
+		probe_pclose(host_model_info);
+		uwu_hw(model, sizeof(model));
+		user_info->host_model = arena_add(&user_info->strings, model);
+		return;
+	}
+#ifdef _WIN32
+	host_model_info = popen("wmic computersystem get model", "r");
+	while (fgets(line, sizeof(line), host_model_info)) {
+		if (strstr(line, "Model") != 0)
+			continue;
+		else {
+			sprintf(model, "%s", line);
+			if (strlen(model) >= 2) model[strlen(model) - 2] = '\0';
+			break;
+		}
+	}
+	pclose(host_model_info);
+#elif defined(__FREEBSD__) || defined(__APPLE__)
+	#if defined(__FREEBSD__)
+		#define HOSTCTL "hw.hv_vendor"
+	#elif defined(__APPLE__)
+		#define HOSTCTL "hw.model"
+	#endif
+	host_model_info = probe_popen("sysctl -a " HOSTCTL);
+	if (!host_model_info) {
+		user_info->host_model = TIMED_OUT;
+		return;
+	}
+	while (fgets(line, sizeof(line), host_model_info))
+		if (sscanf(line, HOSTCTL ": %[^\n]", model)) break;
+	probe_pclose(host_model_info);
+#else
+	host_model_info =
+		root_fopen("/sys/devices/virtual/dmi/id/board_name",
+				   "r"); // try to get board name ("HOWOST" INFO NAME SHOULD BE
+						 // CHANGED AS IT IS NOT MEANT TO BE THE hostname, BUT
+						 // THE MODEL OF THE COMPUTER)
+	if (!host_model_info) // if couldn't then try another
+		host_model_info =
+			root_fopen("/sys/devices/virtual/dmi/id/product_name", "r");
+	if (!host_model_info)									// if failed
+		host_model_info = root_fopen("/etc/hostname", "r"); // etc.
+	if (host_model_info) { // if succeeded to open one of the file
+		if (fgets(line, sizeof(line), host_model_info))
+			sscanf(line, "%[^\n]", model);
+		fclose(host_model_info);
+	}
+	FILE *host_model_version =
+		root_fopen("/sys/devices/virtual/dmi/id/product_version", "r");
+	if (host_model_version) {
+		char version[32];
+		while (fgets(line, sizeof(line), host_model_version)) {
+			if (sscanf(line, "%31[^\n]", version)) {
+				snprintf(model + strlen(model), sizeof(model) - strlen(model),
+						 " %s", version);
+				break;
+			}
+		}
+		fclose(host_model_version);
+	}
+#endif // _WIN32
+	uwu_hw(model, sizeof(model));
+	user_info->host_model = arena_add(&user_info->strings, model);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// the brand string of the cpu, which the kernel shows as the model name in
+// /proc/cpuinfo, returns 0 on cpus too old to have one
+int read_cpuid_brand(char *model, size_t size) {
+	unsigned int brand[13] = {0}; // 3 leaves of 4 registers, and a '\0'
+	if (__get_cpuid_max(0x80000000, NULL) < 0x80000004) return 0;
+	for (unsigned int i = 0; i < 3; i++)
+		__get_cpuid(0x80000002 + i, &brand[i * 4], &brand[i * 4 + 1],
+					&brand[i * 4 + 2], &brand[i * 4 + 3]);
+	char *start = (char *)brand + strspn((char *)brand, " ");
+	size_t len	= strlen(start);
+	while (len > 0 && start[len - 1] == ' ') len--; // padded on some cpus
+	snprintf(model, size, "%.*s", (int)len, start);
+	return len > 0;
+}
+#endif // defined(__x86_64__) || defined(__i386__)
+
+#ifndef _WIN32
+/*
+ Finds the first "key : value" line of /proc/cpuinfo, whatever the spaces and
+tabs around the colon. The file is read in large blocks and only until the
+key is found, it is hundreds of KiB on big servers but the model name is in
+the block of the first cpu.
+*/
+int read_cpuinfo(const char *key, char *value, size_t size) {
+	int fd = root_open("/proc/cpuinfo", O_RDONLY);
+	if (fd < 0) return 0;
+	size_t cap = 16384, len = 0, line = 0, key_len = strlen(key);
+	char *data = malloc(cap);
+	int found = 0, eof = 0;
+	while (data && !found && !eof) {
+		ssize_t bytes = read(fd, data + len, cap - len - 1);
+		eof			  = bytes <= 0;
+		if (!eof) len += bytes;
+		data[len] = '\0';
+		// only the complete lines are parsed, unless the file ended
+		for (char *end; !found && line < len; line = end + 1 - data) {
+			end = strchr(data + line, '\n');
+			if (!end && !eof) break;
+			if (!end) end = data + len;
+			char *c = data + line;
+			if (strncmp(c, key, key_len) != 0) continue;
+			c += key_len + strspn(c + key_len, " \t");
+			if (*c != ':') continue;
+			c += 1 + strspn(c + 1, " \t");
+			snprintf(value, size, "%.*s", (int)(end - c), c);
+			found = 1;
+		}
+		if (len + 1 == cap) { // the next block does not fit
+			char *bigger = realloc(data, cap * 2);
+			if (!bigger) break;
+			data = bigger;
+			cap *= 2;
+		}
+	}
+	free(data);
+	close(fd);
+	return found;
+}
+#endif // _WIN32
+
+// the model name from the os, returns 0 if its command timed out
+int read_cpu_model(struct info *user_info, char *model, size_t size) {
+#ifdef _WIN32
+	char line[256];
+	FILE *cpuinfo = popen("wmic cpu get caption", "r");
+	while (fgets(line, sizeof(line), cpuinfo)) {
+		if (strstr(line, "Caption") != 0)
+			continue;
+		else {
+			snprintf(model, size, "%s", line);
+			if (strlen(model) >= 2) model[strlen(model) - 2] = '\0';
+			break;
+		}
+	}
+	pclose(cpuinfo);
+#elif defined(__APPLE__)
+	(void)user_info;
+	char cpu_buffer[128]  = "";
+	size_t cpu_buffer_len = sizeof(cpu_buffer);
+	sysctlbyname("machdep.cpu.brand_string", cpu_buffer, &cpu_buffer_len, NULL,
+				 0);
+	snprintf(model, size, "%s", cpu_buffer);
+#elif defined(__FREEBSD__)
+	char line[256];
+	FILE *cpuinfo = probe_popen("sysctl -a | egrep -i 'hw.model'");
+	if (!cpuinfo) return 0;
+	while (fgets(line, sizeof(line), cpuinfo))
+		if (sscanf(line, "hw.model: %[^\n]", model)) break;
+	probe_pclose(cpuinfo);
+#else
+	// android kernels on arm do not report a model name
+	read_cpuinfo(strcmp(user_info->version_name, "android") == 0
+					 ? "Hardware"
+					 : "model name",
+				 model, size);
+#endif // _WIN32
+	return 1;
+}
+
+// "<model> (8C/16T) @ 4.7GHz", the counts and clock only on linux
+void collect_cpu(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+	char model[256] = "";
+#if defined(__x86_64__) || defined(__i386__)
+	// the cpu of a UWUFETCH_ROOT is in its /proc/cpuinfo
+	if (!getenv("UWUFETCH_ROOT")) read_cpuid_brand(model, sizeof(model));
+#endif // defined(__x86_64__) || defined(__i386__)
+	if (!model[0] && !read_cpu_model(user_info, model, sizeof(model))) {
+		user_info->cpu_model = TIMED_OUT;
+		return;
+	}
+#ifdef __linux__
+	struct cpu_topology topology = {0};
+	read_cpu_topology(&topology);
+	char *base_clock = strstr(model, " @ "); // in the names of intel cpus
+	if (base_clock && topology.max_khz > 0) *base_clock = '\0';
+#endif // __linux__
+
+	uwu_hw(model, sizeof(model));
+#ifdef __linux__
+	struct strbuf buf = strbuf_wrap(model, sizeof(model));
+	if (topology.sockets > 1)
+		strbuf_printf(&buf, " (%dS/%dC/%dT)", topology.sockets, topology.cores,
+					  topology.threads);
+	else if (topology.threads > 0)
+		strbuf_printf(&buf, " (%dC/%dT)", topology.cores, topology.threads);
+	if (topology.max_khz >= 1000000)
+		strbuf_printf(&buf, " @ %.1fGHz", topology.max_khz / 1e6);
+	else if (topology.max_khz > 0)
+		strbuf_printf(&buf, " @ %ldMHz", topology.max_khz / 1000);
+#endif // __linux__
+	// truncate CPU name, with the counts and clock that are part of it
+	truncate_name(model, user_info->target_width);
+	user_info->cpu_model = arena_add(&user_info->strings, model);
+}
+
+void collect_kernel(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+	char kernel[256] = "";
+	struct strbuf buf = strbuf_wrap(kernel, sizeof(kernel));
+#ifndef _WIN32
+	// "<sysname> <release> <machine>", uwufied while it is written
+	user_info->sys_var = *system_uname();
+	uwu_kernel(&buf, user_info->sys_var.sysname);
+	strbuf_append(&buf, " ", 1);
+	uwu_kernel(&buf, user_info->sys_var.release);
+	strbuf_append(&buf, " ", 1);
+	uwu_kernel(&buf, user_info->sys_var.machine);
+	truncate_name(kernel, user_info->target_width);
+#else  // _WIN32
+	char line[256], system_type[256] = "";
+	FILE *kernel_fp = popen("wmic computersystem get systemtype", "r");
+	while (fgets(line, sizeof(line), kernel_fp)) {
+		if (strstr(line, "SystemType") != 0)
+			continue;
+		else {
+			sprintf(system_type, "%s", line);
+			if (strlen(system_type) >= 2)
+				system_type[strlen(system_type) - 2] = '\0';
+			break;
+		}
+	}
+	if (kernel_fp != NULL) pclose(kernel_fp);
+	uwu_kernel(&buf, system_type);
+#endif // _WIN32
+	user_info->kernel = arena_add(&user_info->strings, kernel);
+}
+
+void collect_ram(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+#ifndef __APPLE__
+	#ifdef _WIN32
+	FILE *mem_used_fp	   = popen("wmic os get freevirtualmemory", "r");
+	FILE *mem_total_fp	   = popen("wmic os get totalvirtualmemorysize", "r");
+	char mem_used_ch[2137] = {0}, mem_total_ch[2137] = {0};
+
+	while (fgets(mem_total_ch, sizeof(mem_total_ch), mem_total_fp) != NULL) {
+		if (strstr(mem_total_ch, "TotalVirtualMemorySize") != 0)
+			continue;
+		else if (strstr(mem_total_ch, "  ") == 0)
+			continue;
+		else
+			user_info->ram_total = atoi(mem_total_ch) / 1024;
+	}
+	while (fgets(mem_used_ch, sizeof(mem_used_ch), mem_used_fp) != NULL) {
+		if (strstr(mem_used_ch, "FreeVirtualMemory") != 0)
+			continue;
+		else if (strstr(mem_used_ch, "  ") == 0)
+			continue;
+		else
+			user_info->ram_used =
+				user_info->ram_total - (atoi(mem_used_ch) / 1024);
+	}
+	pclose(mem_used_fp);
+	pclose(mem_total_fp);
+	#elif defined(__FREEBSD__)
+	char line[256];
+	FILE *meminfo = probe_popen("LANG=EN_us freecolor -om 2> /dev/null");
+	if (!meminfo) {
+		user_info->ram_total = -1;
+		return;
+	}
+	while (fgets(line, sizeof(line), meminfo))
+		// free command prints like this: "Mem:" total     used    free shared
+		// buff/cache      available
+		sscanf(line, "Mem: %d %d", &user_info->ram_total, &user_info->ram_used);
+	probe_pclose(meminfo);
+	#else
+	read_meminfo(user_info);
+	#endif
+#else
+	// Used
+	FILE *mem_wired_fp, *mem_active_fp, *mem_compressed_fp;
+	mem_wired_fp =
+		probe_popen("vm_stat | awk '/wired/ { printf $4 }' | cut -d '.' -f 1");
+	mem_active_fp =
+		probe_popen("vm_stat | awk '/active/ { printf $3 }' | cut -d '.' -f 1");
+	mem_compressed_fp = probe_popen(
+		"vm_stat | awk '/occupied/ { printf $5 }' | cut -d '.' -f 1");
+	if (!mem_wired_fp || !mem_active_fp || !mem_compressed_fp) {
+		if (mem_wired_fp) probe_pclose(mem_wired_fp);
+		if (mem_active_fp) probe_pclose(mem_active_fp);
+		if (mem_compressed_fp) probe_pclose(mem_compressed_fp);
+		user_info->ram_total = -1;
+		return;
+	}
+	char mem_wired_ch[2137], mem_active_ch[2137], mem_compressed_ch[2137];
+	while (fgets(mem_wired_ch, sizeof(mem_wired_ch), mem_wired_fp) != NULL) {
+		while (fgets(mem_active_ch, sizeof(mem_active_ch), mem_active_fp) !=
+			   NULL) {
+			while (fgets(mem_compressed_ch, sizeof(mem_compressed_ch),
+						 mem_compressed_fp) != NULL) {
+			}
+		}
+	}
+
+	probe_pclose(mem_wired_fp);
+	probe_pclose(mem_active_fp);
+	probe_pclose(mem_compressed_fp);
+
+	int mem_wired	   = atoi(mem_wired_ch);
+	int mem_active	   = atoi(mem_active_ch);
+	int mem_compressed = atoi(mem_compressed_ch);
+
+	// Total
+	int64_t mem_buffer	  = 0;
+	size_t mem_buffer_len = sizeof(mem_buffer);
+	sysctlbyname("hw.memsize", &mem_buffer, &mem_buffer_len, NULL, 0);
+
+	user_info->ram_used	 = ((mem_wired + mem_active + mem_compressed) * 4 / 1024);
+	user_info->ram_total = mem_buffer / 1024 / 1024;
+#endif
+}
+
+// cleans and uwufies a gpu name, then adds it to the list
+void add_gpu(struct info *user_info, char *gpu, size_t size) {
+	remove_brackets(gpu);
+	truncate_name(gpu, user_info->target_width);
+	uwu_hw(gpu, size);
+	string_table_add(&user_info->gpu_model, gpu);
+}
+
+void collect_gpu(struct info *user_info, struct configuration *config_flags) {
+	(void)config_flags;
+	char line[256], gpu_name[256];
+	FILE *gpu	  = NULL;
+	int timed_out = 0;
+	string_table_clear(&user_info->gpu_model); // from cache
+#ifdef __linux__
+	// lshw and lspci read the same sysfs directory, if it has no display
+	// controller they would not find one either (android gpus are not on pci)
+	if (read_pci_gpus(user_info) >= 0 &&
+		strcmp(user_info->version_name, "android") != 0)
+		return;
+#endif // __linux__
+#ifndef _WIN32
+	if (user_info->gpu_model.count == 0) { // lshw is slow, it is only run when
+										   // sysfs has nothing
+		gpu = probe_popen("lshw -class display 2> /dev/null");
+
+		// add all gpus to the list
+		if (gpu) {
+			while (fgets(line, sizeof(line), gpu))
+				if (sscanf(line, "    product: %[^\n]", gpu_name) == 1)
+					add_gpu(user_info, gpu_name, sizeof(gpu_name));
+			probe_pclose(gpu);
+			gpu = NULL;
+		} else // lspci can still be fast enough
+			timed_out = 1;
+	}
+#endif // _WIN32
+
+	if (user_info->gpu_model.count == 0 ||
+		strlen(user_info->gpu_model.data) < 2) {
+		// get gpus with lspci command
+		if (strcmp(user_info->version_name, "android") != 0) {
+#ifndef __APPLE__
+	#ifdef _WIN32
+			gpu = popen("wmic PATH Win32_VideoController GET Name", "r");
+	#else
+			gpu = probe_popen("lspci -mm 2> /dev/null | grep \"VGA\" | awk -F "
+							  "'\"' '{print $4 $5 $6}'");
+	#endif
+#else
+			gpu = probe_popen("system_profiler SPDisplaysDataType | awk -F "
+							  "': ' '/Chipset Model: /{ print $2 }'");
+#endif
+		} else
+			gpu = probe_popen("getprop ro.hardware.vulkan 2> /dev/null");
+
+		// get all the gpus
+		while (gpu && fgets(line, sizeof(line), gpu)) {
+			if (strstr(line, "Name"))
+				continue;
+			else if (strlen(line) == 2)
+				continue;
+			// ^^^ for windows
+			else if (sscanf(line, "%[^\n]", gpu_name) == 1)
+				add_gpu(user_info, gpu_name, sizeof(gpu_name));
+		}
+		if (gpu)
+			probe_pclose(gpu);
+		else
+			timed_out = 1;
+	}
+	if (user_info->gpu_model.count == 0 && timed_out)
+		string_table_add(&user_info->gpu_model, TIMED_OUT);
+}
+
+// every connected monitor, without running a command
+void collect_resolution(struct info *user_info,
+						struct configuration *config_flags) {
+	(void)config_flags;
+	user_info->screen_count = 0;
+#ifndef _WIN32
+	#ifdef __linux__
+	// the display server is only asked when there is no drm driver
+	if (read_drm_screens(user_info) >= 0) return;
+	#endif // __linux__
+	read_x11_screens(user_info);
+#endif // _WIN32
+}
+
+void collect_pkgs(struct info *user_info, struct configuration *config_flags) {
+	user_info->pkgman_name = ""; // set by pkgman() when something is found
+#ifdef _WIN32
+	user_info->pkgs = pkgman(user_info, config_flags);
+#else  // _WIN32
+	(void)config_flags;
+	user_info->pkgs = pkgman(user_info);
+#endif // _WIN32
+}
+
+// collectors that are started in the thread pool once the os is known
+struct {
+	int fields; // filled by the collector
+	void (*collect)(struct info *user_info, struct configuration *config_flags);
+} collectors[] = {{FIELD_PKGS, collect_pkgs},
+				  {FIELD_GPU, collect_gpu},
+				  {FIELD_RESOLUTION, collect_resolution},
+				  {FIELD_RAM, collect_ram},
+				  {FIELD_CPU, collect_cpu},
+				  {FIELD_HOST, collect_host},
+				  {FIELD_KERNEL, collect_kernel},
+				  {FIELD_USER, collect_user}};
+#define COLLECTOR_COUNT (int)(sizeof(collectors) / sizeof(collectors[0]))
+#define COLLECTOR_THREADS 8 // slow collectors should never wait for a thread
+
+#define COLLECTOR_ARENA_SIZE 4096 // the strings of a single field
+
+/*
+ Copies an info for a collector, with its strings in an arena of its own and
+no gpus. A collector only writes into such a copy, so that it can be left
+running past the deadline while the info it was started for is rendered.
+Returns 0 if the memory could not be allocated.
+*/
+int copy_info(struct info *to, const struct info *from) {
+	*to			  = *from;
+	to->gpu_model = (struct string_table){0};
+	if (!arena_init(&to->strings, COLLECTOR_ARENA_SIZE)) return 0;
+#define INFO_STRING_COPY(field) \
+	to->field = arena_add(&to->strings, from->field);
+	INFO_STRINGS(INFO_STRING_COPY)
+#undef INFO_STRING_COPY
+	return 1;
+}
+
+// copies what the collector of field filled
+void merge_field(struct info *to, struct info *from, int field) {
+	switch (field) {
+	case FIELD_USER:
+		to->user  = arena_add(&to->strings, from->user);
+		to->host  = arena_add(&to->strings, from->host);
+		to->shell = arena_add(&to->strings, from->shell);
+		break;
+	case FIELD_HOST:
+		to->host_model = arena_add(&to->strings, from->host_model);
+		break;
+	case FIELD_CPU:
+		to->cpu_model = arena_add(&to->strings, from->cpu_model);
+		break;
+	case FIELD_KERNEL:
+		to->kernel = arena_add(&to->strings, from->kernel);
+#ifndef _WIN32
+		to->sys_var = from->sys_var;
+#endif // _WIN32
+		break;
+	case FIELD_RAM:
+		to->ram_total		= from->ram_total;
+		to->ram_used		= from->ram_used;
+		to->swap_total		= from->swap_total;
+		to->swap_used		= from->swap_used;
+		to->buff_cache		= from->buff_cache;
+		to->hugepages_total = from->hugepages_total;
+		to->hugepages_used	= from->hugepages_used;
+		break;
+	case FIELD_GPU:
+		string_table_clear(&to->gpu_model);
+		STRING_TABLE_FOREACH(&from->gpu_model, gpu)
+			string_table_add(&to->gpu_model, gpu);
+		break;
+	case FIELD_RESOLUTION:
+		to->screen_count = from->screen_count;
+		memcpy(to->screens, from->screens, sizeof(to->screens));
+		break;
+	case FIELD_PKGS:
+		to->pkgs		= from->pkgs;
+		to->pkgman_name = arena_add(&to->strings, from->pkgman_name);
+		break;
+	}
+}
+
+// a collector that did not finish in time, its fields are shown as TIMED_OUT
+void merge_timed_out(struct info *to, int field) {
+	struct info late = {.user		 = TIMED_OUT,
+						.host		 = TIMED_OUT,
+						.shell		 = TIMED_OUT,
+						.host_model	 = TIMED_OUT,
+						.kernel		 = TIMED_OUT,
+						.cpu_model	 = TIMED_OUT,
+						.pkgman_name = TIMED_OUT,
+						.ram_total	 = -1};
+#ifndef _WIN32
+	late.sys_var = to->sys_var;
+#endif // _WIN32
+	string_table_add(&late.gpu_model, TIMED_OUT);
+	merge_field(to, &late, field);
+	free(late.gpu_model.data);
+}
+
+/*
+ The collectors of a get_info() call. The call only waits for them until the
+collect deadline, so the pool is freed by whoever lets it go last, and the
+collectors work on copies of base: a late one finds user_info set to NULL
+and drops what it collected.
+*/
+struct collector_pool {
+	struct info *user_info;				// NULL once get_info() returned
+	struct info base;					// what the collectors start from
+	struct configuration config_flags; // a copy, like base
+	int fields; // the collectors of the other fields are skipped
+	int next;	// index of the next collector to run
+	int left;	// collectors that did not finish yet
+	int done;	// the fields merged into user_info
+	int refs;	// get_info() and the workers still using the pool
+	pthread_mutex_t lock;
+	pthread_cond_t finished;
+};
+
+// drops a reference to the pool, the last one frees it
+void release_pool(struct collector_pool *pool) {
+	pthread_mutex_lock(&pool->lock);
+	int last = --pool->refs == 0;
+	pthread_mutex_unlock(&pool->lock);
+	if (!last) return;
+	free_info(&pool->base);
+	free(pool);
+}
+
+void *collector_worker(void *arg) {
+	struct collector_pool *pool = arg;
+	while (1) {
+		pthread_mutex_lock(&pool->lock);
+		int current = pool->next++;
+		pthread_mutex_unlock(&pool->lock);
+		if (current >= COLLECTOR_COUNT) break;
+		if (!(collectors[current].fields & pool->fields)) continue;
+		long start = profile_begin();
+		struct info copy;
+		int copied = copy_info(&copy, &pool->base);
+		if (copied) collectors[current].collect(&copy, &pool->config_flags);
+		int field = 0; // every collector fills a single field
+		while (1 << field != collectors[current].fields) field++;
+		profile_end(start, "collect %s", field_names[field]);
+
+		pthread_mutex_lock(&pool->lock);
+		if (copied && pool->user_info) {
+			merge_field(pool->user_info, &copy, collectors[current].fields);
+			pool->done |= collectors[current].fields;
+		}
+		pool->left--;
+		pthread_cond_signal(&pool->finished);
+		pthread_mutex_unlock(&pool->lock);
+		if (copied) free_info(&copy);
+	}
+	release_pool(pool);
+	return NULL;
+}
+
+// get the info of the selected fields, the others are not touched
+void get_info(struct configuration *config_flags, struct info *user_info,
+			  int fields) {
+
+// terminal width used to truncate long names
+#ifndef _WIN32
+	ioctl(STDOUT_FILENO, TIOCGWINSZ, &user_info->win);
+	user_info->target_width = user_info->win.ws_col - 30;
+#else  // _WIN32
+	GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
+	user_info->ws_col  = csbi.srWindow.Right - csbi.srWindow.Left - 29;
+	user_info->ws_rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+#endif // _WIN32
+
+	// the other collectors need to know the os, it is just a file read
+	if (fields & FIELD_OS) {
+		long start = profile_begin();
+		collect_os(user_info, config_flags);
+		profile_end(start, "collect os");
+	}
+	compute_fingerprints(user_info->fingerprints, fields);
+	int64_t now = time(NULL);
+	for (int i = 0; i < FIELD_COUNT; i++)
+		if (fields & 1 << i) user_info->collected[i] = now;
+
+#ifndef __APPLE__
+	#ifndef __FREEBSD__
+		#ifndef _WIN32
+	sysinfo(&user_info->sys); // somehow this function has to be called again in
+							 // print_info()
+		#else				 // _WIN32
+	GetSystemInfo(&user_info->sys);
+		#endif				 // _WIN32
+	#endif
+#endif
+
+	// every collector is independent, so the total time is the time of the
+	// slowest one instead of the sum of all of them
+	int collector_fields = 0, left = 0;
+	for (int i = 0; i < COLLECTOR_COUNT; i++) {
+		collector_fields |= collectors[i].fields;
+		if (collectors[i].fields & fields) left++;
+	}
+	struct collector_pool *pool = malloc(sizeof(*pool));
+	if (!pool || !copy_info(&pool->base, user_info)) {
+		free(pool); // without memory for the copies they run here, in order
+		for (int i = 0; i < COLLECTOR_COUNT; i++)
+			if (collectors[i].fields & fields)
+				collectors[i].collect(user_info, config_flags);
+		return;
+	}
+	pool->user_info	   = user_info;
+	pool->config_flags = *config_flags;
+	pool->fields	   = fields;
+	pool->next		   = 0;
+	pool->left		   = left;
+	pool->done		   = 0;
+	pool->refs		   = 1 + COLLECTOR_THREADS;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->finished, NULL);
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	int started = 0;
+	for (; started < COLLECTOR_THREADS && started < COLLECTOR_COUNT; started++) {
+		pthread_t thread;
+		if (pthread_create(&thread, &attr, collector_worker, pool)) break;
+	}
+	pthread_attr_destroy(&attr);
+	if (started == 0) { // no threads, run them here
+		started = 1;
+		collector_worker(pool);
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->refs -= COLLECTOR_THREADS - started; // the threads that did not start
+	while (pool->left > 0) {
+#ifndef _WIN32
+		long remaining = collect_deadline - monotonic_ms();
+		if (collect_deadline && remaining <= 0) break;
+		if (collect_deadline) { // the condition waits on the wall clock
+			struct timespec until;
+			clock_gettime(CLOCK_REALTIME, &until);
+			until.tv_sec += remaining / 1000;
+			until.tv_nsec += remaining % 1000 * 1000000;
+			if (until.tv_nsec >= 1000000000) {
+				until.tv_sec++;
+				until.tv_nsec -= 1000000000;
+			}
+			pthread_cond_timedwait(&pool->finished, &pool->lock, &until);
+			continue;
+		}
+#endif // _WIN32
+		pthread_cond_wait(&pool->finished, &pool->lock);
+	}
+	pool->user_info = NULL; // the collectors still running are dropped
+	int late		= fields & collector_fields & ~pool->done;
+	pthread_mutex_unlock(&pool->lock);
+#ifndef _WIN32
+	if (late) kill_probes(); // they would outlive the run
+#endif // _WIN32
+	release_pool(pool);
+	for (int i = 0; i < FIELD_COUNT; i++)
+		if (late & 1 << i) merge_timed_out(user_info, 1 << i);
+}
+
+int compare_logo(const void *name, const void *logo) {
+	return strcmp(name, ((const struct logo *)logo)->name);
+}
+
+void print_ascii(
+	struct info *user_info) { // prints logo (as ascii art) of the given system.
+	long start = profile_begin();
+	out_printf("\n");
+	// a file in the config directory overrides the built in logo, it is the
+	// only path that is tried
+	FILE *file = NULL;
+	if (getenv("HOME")) {
+		char ascii_file[1024];
+		snprintf(ascii_file, sizeof(ascii_file),
+				 "%s/.config/uwufetch/ascii/%s.txt", getenv("HOME"),
+				 user_info->version_name);
+		file = fopen(ascii_file, "r");
+	}
+	if (file) {
+		char logo[8192]; // the biggest logo is less than 2 KiB
+		size_t len = fread(logo, 1, sizeof(logo), file);
+		fclose(file);
+		expand_logo(logo, len);
+	} else {
+		struct logo *logo = bsearch(user_info->version_name, logos, LOGO_COUNT,
+									sizeof(logos[0]), compare_logo);
+		if (!logo) {
+			user_info->version_name = "unknown";
+			logo = bsearch("unknown", logos, LOGO_COUNT, sizeof(logos[0]),
+						   compare_logo);
+		}
+		if (logo) out_write(logo->art, strlen(logo->art));
+	}
+	// Always set color to NORMAL, so there's no need to do this in every ascii
+	// file.
+	out_printf(NORMAL);
+	profile_end(start, "logo");
+}
+
+struct logo_token {
+	const char *name, *value;
+};
+
+int compare_logo_token(const void *key, const void *token) {
+	const char *name = key; // terminated by '}'
+	const char *token_name = ((const struct logo_token *)token)->name;
+	size_t len			   = strcspn(name, "}");
+	int result			   = strncmp(name, token_name, len);
+	return result ? result : -(token_name[len] != '\0');
+}
+
+/*
+ Copies the logo to the output in a single pass, replacing every {NAME}
+placeholder with its escape sequence. Placeholders that are not known are
+printed as they are.
+*/
+void expand_logo(const char *logo, size_t len) {
+#define X(name) {#name, name},
+	static const struct logo_token tokens[] = {LOGO_TOKENS};
+#undef X
+	const size_t token_count = sizeof(tokens) / sizeof(tokens[0]);
+	const char *end			 = logo + len;
+	while (logo < end) {
+		const char *open = memchr(logo, '{', end - logo);
+		if (!open) open = end;
+		out_write(logo, open - logo); // literal text before the placeholder
+		logo = open;
+		if (open == end) break;
+		const char *close = memchr(open, '}', end - open);
+		const struct logo_token *token = NULL;
+		if (close && close - open <= 32)
+			token = bsearch(open + 1, tokens, token_count, sizeof(tokens[0]),
+							compare_logo_token);
+		if (token) {
+			out_write(token->value, strlen(token->value));
+			logo = close + 1;
+		} else {
+			out_write(open, 1);
+			logo++;
+		}
+	}
+}
+
+void print_image(
+	struct info *user_info) { // prints logo (as an image) of the given system.
+							  // distributions listed alphabetically.
+#ifndef TARGET_OS_IPHONE
+	char command[256];
+	if (strlen(user_info->image_name) > 1)
+		sprintf(command, "viu -t -w 18 -h 8 %s 2> /dev/null",
+				user_info->image_name);
+	else {
+		if (strcmp(user_info->version_name, "android") == 0)
+			sprintf(command,
+					"viu -t -w 18 -h 8 "
+					"/data/data/com.termux/files/usr/lib/uwufetch/%s.png 2> "
+					"/dev/null",
+					user_info->version_name);
+		else
+			sprintf(command,
+					"viu -t -w 18 -h 8 /usr/lib/uwufetch/%s.png 2> /dev/null",
+					user_info->version_name);
+	}
+	out_printf("\n");
+	flush_output(); // viu writes straight to the terminal
+	if (system(command) !=
+		0) { // if viu is not installed or the image is missing
+		out_printf("\033[0E\033[3C%s\n"
+			   "   There was an\n"
+			   "    error: viu\n"
+			   " is not installed\n"
+			   "   or the image\n"
+			   "   is not found\n"
+			   "  Read IMAGES.md\n"
+			   "   for more info.\n\n",
+			   RED);
+	}
+#else
+	// unfortunately, the iOS stdlib does not have
+	// system();
+	// because it reports that it is not available under iOS during compilation
+	out_printf("\033[0E\033[3C%s\n"
+		   "   There was an\n"
+		   "   error: images\n"
+		   "   are currently\n"
+		   "  disabled on iOS.\n\n",
+		   RED);
+#endif
+}
+
+struct distro_key {
+	const char *name; // not terminated
+	size_t len;
+};
+
+int compare_distro_name(const void *key, const void *distro) {
+	const struct distro_key *word = key;
+	const char *name			  = ((const struct distro_name *)distro)->name;
+	int result					  = strncmp(word->name, name, word->len);
+	return result ? result : -(name[word->len] != '\0');
+}
+
+// the names of ~/.config/uwufetch/distros, read on the first lookup
+struct distro_name *user_names = NULL;
+int user_name_count				= 0;
+pthread_once_t user_names_once	= PTHREAD_ONCE_INIT;
+
+void read_user_names(void) {
+	char path[512], line[256];
+	FILE *file = NULL;
+	if (getenv("HOME")) {
+		snprintf(path, sizeof(path), "%s/.config/uwufetch/distros",
+				 getenv("HOME"));
+		file = fopen(path, "r");
+	}
+	while (file && fgets(line, sizeof(line), file)) {
+		char *separator = strchr(line, '=');
+		if (line[0] == '#' || !separator) continue;
+		*separator = '\0';
+		separator[strcspn(separator + 1, "\r\n") + 1] = '\0';
+		struct distro_name *names =
+			realloc(user_names, (user_name_count + 1) * sizeof(*names));
+		if (!names) break;
+		user_names = names;
+		user_names[user_name_count].name  = strdup(line);
+		user_names[user_name_count++].uwu = strdup(separator + 1);
+	}
+	if (file) fclose(file);
+}
+
+/*
+ Returns the uwufied name, or NULL when there is none. The names in
+~/.config/uwufetch/distros, one name=uwufied name per line like in
+res/distros, are checked before the built in ones.
+*/
+const char *uwu_lookup(const char *name, size_t len) {
+	// more threads can render at the same time
+	pthread_once(&user_names_once, read_user_names);
+	for (int i = 0; i < user_name_count; i++)
+		if (user_names[i].name && user_names[i].uwu &&
+			strncmp(name, user_names[i].name, len) == 0 &&
+			user_names[i].name[len] == '\0')
+			return user_names[i].uwu;
+	struct distro_key key	   = {name, len};
+	struct distro_name *distro = bsearch(&key, distro_names, DISTRO_NAME_COUNT,
+										 sizeof(distro_names[0]),
+										 compare_distro_name);
+	return distro ? distro->uwu : NULL;
+}
+
+/*
+ Appends text to buf one word at a time, the words with an uwufied name are
+replaced by it. The words are looked up where they are, so text is never
+copied or modified and has no limit on its number of words.
+*/
+void uwu_kernel(struct strbuf *buf, const char *text) {
+	long profile_start = profile_begin();
+	while (1) {
+		size_t len		= strcspn(text, " ");
+		const char *uwu = uwu_lookup(text, len);
+		if (uwu)
+			strbuf_append(buf, uwu, strlen(uwu));
+		else
+			strbuf_append(buf, text, len);
+		if (text[len] == '\0') break;
+		strbuf_append(buf, " ", 1);
+		text += len + 1;
+	}
+	profile_end(profile_start, "uwu_kernel");
+}
+
+// hardware names and their uwufied version, matched ignoring the case
+struct hw_name {
+	const char *original, *uwufied;
+} hw_names[] = {
+	{"lenovo", "LenOwO"},		   {"cpu", "CPUwU"},
+	{"gpu", "GPUwU"},			   {"graphics", "Gwaphics"},
+	{"corporation", "COwOpowation"}, {"nvidia", "NyaVIDIA"},
+	{"mobile", "Mwobile"},		   {"intel", "Inteww"},
+	{"radeon", "Radenyan"},		   {"geforce", "GeFOwOce"},
+	{"raspberry", "Nyasberry"},	   {"broadcom", "Bwoadcom"},
+	{"motorola", "MotOwOwa"},	   {"proliant", "ProLinyant"},
+	{"poweredge", "POwOwEdge"},	   {"apple", "Nyapple"},
+	{"electronic", "ElectrOwOnic"}};
+#define HW_NAME_COUNT (int)(sizeof(hw_names) / sizeof(hw_names[0]))
+#define HW_STATES 256 // more than the letters of all the names
+#define HW_CLASSES 27 // the names are only letters, anything else is 0
+
+/*
+ Aho-Corasick automaton of hw_names, built once. Every state has a
+transition for every class, so matching is a table lookup per character.
+*/
+struct {
+	uint8_t next[HW_STATES][HW_CLASSES];
+	int8_t match[HW_STATES]; // the name that ends in this state, or -1
+	int state_count;
+} hw_matcher;
+pthread_once_t hw_matcher_once = PTHREAD_ONCE_INIT;
+
+int hw_class(unsigned char c) {
+	c = tolower(c);
+	return c >= 'a' && c <= 'z' ? c - 'a' + 1 : 0;
+}
+
+void build_hw_matcher(void) {
+	uint8_t fail[HW_STATES] = {0}, queue[HW_STATES];
+	memset(hw_matcher.match, -1, sizeof(hw_matcher.match));
+	hw_matcher.state_count = 1;
+	for (int i = 0; i < HW_NAME_COUNT; i++) { // the trie of the names
+		int state = 0;
+		for (const char *c = hw_names[i].original; *c; c++) {
+			uint8_t *next = &hw_matcher.next[state][hw_class(*c)];
+			if (!*next) *next = hw_matcher.state_count++;
+			state = *next;
+		}
+		hw_matcher.match[state] = i;
+	}
+	// breadth first, the failure of a state is always known before its
+	// children, missing transitions become the ones of the failure state
+	int head = 0, tail = 0;
+	for (int c = 0; c < HW_CLASSES; c++)
+		if (hw_matcher.next[0][c]) queue[tail++] = hw_matcher.next[0][c];
+	while (head < tail) {
+		int state = queue[head++];
+		if (hw_matcher.match[state] < 0)
+			hw_matcher.match[state] = hw_matcher.match[fail[state]];
+		for (int c = 0; c < HW_CLASSES; c++) {
+			uint8_t *next = &hw_matcher.next[state][c];
+			if (*next) {
+				fail[*next]	   = hw_matcher.next[fail[state]][c];
+				queue[tail++] = *next;
+			} else
+				*next = hw_matcher.next[fail[state]][c];
+		}
+	}
+}
+
+/*
+ Uwufies the hardware names of hwname in a single pass, size is the one of
+hwname. The text between the matches and the uwufied names are appended to a
+separate buffer, like in uwu_kernel(), so the tail is never moved, which is
+then copied back.
+*/
+void uwu_hw(char *hwname, size_t size) {
+	long start = profile_begin();
+	pthread_once(&hw_matcher_once, build_hw_matcher);
+	char stack[256], *data = size <= sizeof(stack) ? stack : malloc(size);
+	if (!data) return;
+	data[0]			   = '\0';
+	struct strbuf name = strbuf_wrap(data, size);
+	size_t hw_len = strnlen(hwname, size - 1), copied = 0; // appended up to
+	int state	  = 0;
+	for (size_t i = 0; i < hw_len; i++) {
+		state	  = hw_matcher.next[state][hw_class(hwname[i])];
+		int match = hw_matcher.match[state];
+		if (match < 0) continue;
+		size_t len = strlen(hw_names[match].original);
+		strbuf_append(&name, hwname + copied, i + 1 - len - copied);
+		strbuf_append(&name, hw_names[match].uwufied,
+					  strlen(hw_names[match].uwufied));
+		copied = i + 1;
+		state  = 0; // matches never overlap, like with one replace at a time
+	}
+	strbuf_append(&name, hwname + copied, hw_len - copied);
+	memcpy(hwname, name.data, name.len + 1);
+	if (data != stack) free(data);
+	profile_end(start, "uwu_hw");
+}
+
+void uwu_name(struct configuration *config_flags,
+			  struct info *user_info) { // uwufies distro name
+	long start		= profile_begin();
+	const char *uwu =
+		uwu_lookup(user_info->version_name, strlen(user_info->version_name));
+	profile_end(start, "uwu_name");
+	if (uwu)
+		user_info->version_name = uwu;
+	else {
+		user_info->version_name = "unknown";
+		if (config_flags->ascii_image_flag == 1) {
+			print_image(user_info);
+			out_printf("\n");
+		}
+	}
+}
+
+void truncate_name(char *name, int target_width) {
+	if (target_width <= 0) return; // not a terminal, like in uwu_collect()
+	char arr[target_width];
+
+	for (int i = 0; i < target_width; i++) arr[i] = name[i];
+	name = arr;
+}
+
+// remove square brackets (for gpu names)
+void remove_brackets(char *str) {
+	int i = 0, j;
+	while (i < (int)strlen(str)) {
+		if (str[i] == '[' || str[i] == ']') {
+			for (j = i; j < (int)strlen(str); j++) str[j] = str[j + 1];
+		} else
+			i++;
+	}
+}
+
+// the api of uwufetch.h
+struct uwu_info {
+	struct info info;
+	struct configuration config; // shows the fields collected so far
+};
+
+struct uwu_info *uwu_info_new(void) {
+	struct uwu_info *info = calloc(1, sizeof(*info));
+	if (!info) return NULL;
+	if (!init_info(&info->info)) {
+		free(info);
+		return NULL;
+	}
+	info->config.probe_timeout = PROBE_TIMEOUT;
+	info->config.total_timeout = TOTAL_TIMEOUT;
+	info->config.show_uptime = info->config.show_colors = 1;
+	return info;
+}
+
+// the probes share their deadline, so the calls collect one at a time
+pthread_mutex_t collect_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void uwu_collect(int fields, struct uwu_info *info) {
+	pthread_mutex_lock(&collect_lock);
+	fields = (fields & FIELD_ALL) | FIELD_OS;
+	struct configuration *config = &info->config;
+	show_fields(config, enabled_fields(config) | fields);
+	config->show_swap = config->show_buff_cache = config->show_hugepages =
+		config->show_ram;
+#ifndef _WIN32
+	probe_timeout	 = config->probe_timeout;
+	collect_deadline = monotonic_ms() + config->total_timeout;
+#endif // _WIN32
+	get_info(config, &info->info, fields);
+	// every collect adds its strings to the arena, like a daemon refresh
+	if (info->info.strings.size > info->info.strings.cap / 2)
+		compact_info(&info->info);
+	pthread_mutex_unlock(&collect_lock);
+}
+
+/*
+ The output of the thread points to buf while the info is rendered. A copy
+of the info is rendered, so that the uwufied name and the fallback logo never
+end up in it, with the uptime read again and lines that are never cut.
+*/
+int uwu_render(struct uwu_info *info, int format, char *buf, size_t len) {
+	if (len == 0) return -1;
+	buf[0]				 = '\0';
+	struct output target = {{buf, 0, len}, 0, 0}, *terminal = output;
+
+	struct info copy			= info->info;
+	struct configuration config = info->config;
+	config.output_format		= format;
+	copy.uptime					= 0;
+#ifdef __linux__
+	sysinfo(&copy.sys);
+#endif // __linux__
+#ifndef _WIN32
+	copy.win.ws_col = 0;
+#else  // _WIN32
+	copy.ws_col = 0;
+#endif // _WIN32
+	output = &target;
+	if (format == FORMAT_ART) {
+		print_ascii(&copy);
+		print_info(&config, &copy);
+	} else
+		print_format(&config, &copy);
+	output = terminal;
+	return target.cut ? -1 : (int)target.buf.len;
+}
+
+void uwu_info_free(struct uwu_info *info) {
+	if (!info) return;
+	free_info(&info->info);
+	free(info);
+}
@@ -0,0 +1,348 @@
+/*
+ *  UwUfetch is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ What the collectors, the uwuifier and the renderer of fetch.c share with
+uwufetch.c. Programs that link libuwufetch only need uwufetch.h, nothing in
+here is part of its stable API.
+*/
+#ifndef FETCH_H
+#define FETCH_H
+
+#define _GNU_SOURCE // for strcasestr
+
+#ifdef __APPLE__
+	#include <TargetConditionals.h> // for checking iOS
+#endif
+#include <ctype.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__APPLE__) || defined(__FREEBSD__)
+	#include <sys/sysctl.h>
+	#include <time.h>
+#else // defined(__APPLE__) || defined(__FREEBSD__)
+	#ifdef __FREEBSD__
+	#else // defined(__FREEBSD__) || defined(_WIN32)
+		#ifndef _WIN32
+			#include <sys/sysinfo.h>
+		#else // _WIN32
+			#include <sysinfoapi.h>
+		#endif // _WIN32
+	#endif	   // defined(__FREEBSD__) || defined(_WIN32)
+#endif		   // defined(__APPLE__) || defined(__FREEBSD__)
+#if defined(__x86_64__) || defined(__i386__)
+	#include <cpuid.h>
+#endif // defined(__x86_64__) || defined(__i386__)
+#ifndef _WIN32
+	#include <dlfcn.h>
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <sys/ioctl.h>
+	#include <sys/mman.h>
+	#include <sys/socket.h>
+	#include <sys/un.h>
+	#include <sys/utsname.h>
+	#include <sys/wait.h>
+	#include <time.h>
+#else // _WIN32
+	#include <windows.h>
+#endif // _WIN32
+#include "uwufetch.h"
+
+// COLORS
+#define NORMAL "\x1b[0m"
+#define BOLD "\x1b[1m"
+#define BLACK "\x1b[30m"
+#define RED "\x1b[31m"
+#define GREEN "\x1b[32m"
+#define SPRING_GREEN "\x1b[38;5;120m"
+#define YELLOW "\x1b[33m"
+#define BLUE "\x1b[34m"
+#define MAGENTA "\x1b[0;35m"
+#define CYAN "\x1b[36m"
+#define WHITE "\x1b[37m"
+#define PINK "\x1b[38;5;201m"
+#define LPINK "\x1b[38;5;213m"
+
+#define BACKGROUND_GREEN "\x1b[0;42m"
+#define BACKGROUND_RED "\x1b[0;41m"
+#define BACKGROUND_WHITE "\x1b[0;47m"
+
+#ifdef _WIN32
+	#define BLOCK_CHAR "\xdb"
+	#define BLOCK "\xdc"
+	#define BLOCK_VERTICAL "\xdb"
+#else // _WIN32
+	#define BLOCK_CHAR "\u2587"
+	#define BLOCK "\u2584"
+	#define BLOCK_VERTICAL "\u2587"
+#endif // _WIN32
+// default deadlines in milliseconds, see the timeout= config key
+#define PROBE_TIMEOUT 2000
+#define TOTAL_TIMEOUT 3000
+#define PROBE_MARGIN 50 // ms between the probe and the collect deadlines
+#define MAX_PROBES 64	// tracked to be killed by get_info(), more run untracked
+
+// groups of fields, each one is filled by a single collector, the bits are
+// the ones of the api
+#define FIELD_OS UWU_FIELD_OS
+#define FIELD_USER UWU_FIELD_USER // user, host and shell
+#define FIELD_HOST UWU_FIELD_HOST
+#define FIELD_CPU UWU_FIELD_CPU
+#define FIELD_KERNEL UWU_FIELD_KERNEL
+#define FIELD_RAM UWU_FIELD_RAM
+#define FIELD_GPU UWU_FIELD_GPU
+#define FIELD_RESOLUTION UWU_FIELD_RESOLUTION
+#define FIELD_PKGS UWU_FIELD_PKGS
+#define FIELD_COUNT 9
+#define FIELD_ALL UWU_FIELD_ALL
+// names used by the cache.<field>= config keys, in the order of the bits
+extern char *field_names[FIELD_COUNT];
+#define CACHE_FOREVER -1 // ttl of the fields that only expire with their
+						 // fingerprint
+
+// sources of the cached fields, when one of them changes the fields that
+// depend on it are collected again
+enum {
+	FINGERPRINT_OS,
+	FINGERPRINT_KERNEL,
+	FINGERPRINT_PKGS,
+	FINGERPRINT_GPU,
+	FINGERPRINT_RESOLUTION,
+	FINGERPRINT_COUNT
+};
+
+// all flags available
+struct configuration {
+	int ascii_image_flag, // when (0) ascii is printed, when (1) image is
+						  // printed
+		show_user_info, show_os, show_host, show_kernel, show_cpu, show_gpu,
+		show_ram, show_resolution, show_shell, show_pkgs, show_uptime,
+		show_colors, show_swap, show_buff_cache,
+		show_hugepages; // the last three are disabled by default
+	int probe_timeout, total_timeout; // milliseconds a single command and
+									  // all the collectors can take
+	int cache_format;				  // CACHE_BINARY or CACHE_TEXT
+	int output_format; // FORMAT_ART, or one of the formats of --format
+	char distro[64]; // overrides the detected distribution when set
+	long cache_ttl[FIELD_COUNT]; // seconds a cached field is used for
+};
+
+// a connected monitor, the ones after MAX_SCREENS are not shown
+#define MAX_SCREENS 8
+struct screen {
+	int32_t width, height;
+};
+// the cpus shown after the model name
+struct cpu_topology {
+	int sockets, cores, threads;
+	long max_khz; // 0 when there is no cpufreq driver, like in most vms
+};
+
+#define CACHE_BINARY 0
+#define CACHE_TEXT 1
+// the formats without logo and escape sequences are meant for scripts
+#define FORMAT_ART UWU_FORMAT_ART
+#define FORMAT_JSON UWU_FORMAT_JSON
+#define FORMAT_KV UWU_FORMAT_KV
+#define FORMAT_ENV UWU_FORMAT_ENV
+
+// a string that knows its length and never grows past its capacity, what does
+// not fit is cut and reported to the caller
+struct strbuf {
+	char *data;
+	size_t len, cap; // cap counts the terminating '\0'
+};
+// the whole frame is rendered here and reaches the terminal with a single
+// write, so slow terminals never show it half drawn
+#define OUTPUT_SIZE 16384
+struct output {
+	struct strbuf buf;
+	int flush; // 0 for the buffer of uwu_render(), which is only cut
+	int cut;   // something did not fit a buffer that is never flushed
+};
+// the terminal, unless the thread is in uwu_render()
+extern _Thread_local struct output *output;
+// --profile: how long each stage took, printed to stderr at exit
+#define PROFILE_STAGES 64
+struct profile_stage {
+	char name[48];
+	long us; // of all the calls with the same name
+	int calls;
+};
+struct profile {
+	int enabled, json;
+	long start; // when main() started
+	int count;
+	struct profile_stage stages[PROFILE_STAGES];
+	pthread_mutex_t lock; // the collectors record from their threads
+};
+extern struct profile profile;
+#ifndef _WIN32
+// deadlines used by probe_fork(), collect_deadline is an absolute time
+extern long probe_timeout, collect_deadline;
+#endif // _WIN32
+// strings packed one after the other in a single allocation that grows as
+// needed, each one nul terminated
+struct string_table {
+	char *data;
+	size_t size, cap; // bytes used and allocated
+	int count;
+};
+#define STRING_TABLE_FOREACH(table, str)                            \
+	for (char *str = (table)->data;                                 \
+		 (table)->size && str < (table)->data + (table)->size; \
+		 str += strlen(str) + 1)
+// bump allocator for the strings of a run, allocated once and freed at exit
+#define ARENA_SIZE 16384 // the strings of a run need only a few KiB
+struct arena {
+	char *data;
+	size_t size, cap;
+	pthread_mutex_t lock; // the collectors add strings from their threads
+};
+// the strings of struct info, they point into its arena or to constants
+#define INFO_STRINGS(X)                                                    \
+	X(user) X(host) X(shell) X(host_model) X(kernel) X(version_name)       \
+		X(cpu_model) X(pkgman_name) X(image_name)
+struct info {
+	const char *user, *host, *shell, *host_model, *kernel, *version_name,
+		*cpu_model, *pkgman_name, *image_name;
+	char *config_directory, *cache_content;
+	struct arena strings;
+	struct string_table gpu_model; // any number of gpus
+	struct screen screens[MAX_SCREENS];
+	int target_width, screen_count, ram_total, ram_used, pkgs, swap_total,
+		swap_used, buff_cache, hugepages_total,
+		hugepages_used; // memory values are in MiB
+	long uptime;
+	uint64_t fingerprints[FINGERPRINT_COUNT]; // of the collected fields
+	int64_t collected[FIELD_COUNT];			  // when each field was collected
+
+#ifndef _WIN32
+	struct utsname sys_var;
+#endif // _WIN32
+#ifndef __APPLE__
+	#ifdef __linux__
+	struct sysinfo sys;
+	#else // __linux__
+		#ifdef _WIN32
+	struct _SYSTEM_INFO sys;
+		#endif // _WIN32
+	#endif	   // __linux__
+#endif		   // __APPLE__
+#ifndef _WIN32
+	struct winsize win;
+#else  // _WIN32
+	int ws_col, ws_rows;
+#endif // _WIN32
+};
+
+// functions of fetch.c
+long monotonic_us(void);
+long profile_begin(void);
+void profile_end(long start, const char *format, ...);
+void print_profile(void);
+#ifdef _WIN32
+int pkgman(struct info *user_info, struct configuration *config_flags);
+#else  // _WIN32
+int pkgman(struct info *user_info);
+#endif // _WIN32
+void print_info(struct configuration *config_flags, struct info *user_info);
+void print_format(struct configuration *config_flags, struct info *user_info);
+long get_uptime(struct info *user_info);
+size_t out_vprintf(const char *format, va_list args);
+void out_printf(const char *format, ...);
+void out_line(int width, const char *format, ...);
+void out_write(const char *data, size_t len);
+struct strbuf strbuf_wrap(char *data, size_t cap);
+int string_table_add(struct string_table *table, const char *str);
+void string_table_clear(struct string_table *table);
+int arena_init(struct arena *arena, size_t cap);
+char *arena_copy(struct arena *arena, const char *data, size_t len);
+const char *arena_add(struct arena *arena, const char *str);
+int init_info(struct info *user_info);
+void compact_info(struct info *user_info);
+void free_info(struct info *user_info);
+int strbuf_append(struct strbuf *buf, const char *str, size_t len);
+int strbuf_replace(struct strbuf *buf, size_t start, size_t len,
+				   const char *with, size_t with_len);
+int strbuf_vprintf(struct strbuf *buf, const char *format, va_list args);
+int strbuf_printf(struct strbuf *buf, const char *format, ...);
+void expand_logo(const char *logo, size_t len);
+void flush_output(void);
+void get_info(struct configuration *config_flags, struct info *user_info,
+			  int fields);
+void compute_fingerprints(uint64_t *fingerprints, int fields);
+int enabled_fields(struct configuration *config_flags);
+void show_fields(struct configuration *config_flags, int fields);
+int stale_fields(struct configuration *config_flags, struct info *user_info);
+#ifdef __linux__
+void read_meminfo(struct info *user_info);
+#endif // __linux__
+const char *root_path(const char *path, char *buf, size_t size);
+FILE *root_fopen(const char *path, const char *mode);
+DIR *root_opendir(const char *path);
+#ifndef _WIN32
+const struct utsname *system_uname(void);
+int root_open(const char *path, int flags);
+long monotonic_ms(void);
+FILE *probe_fork(void (*probe)(void *arg), void *arg);
+FILE *probe_popen(const char *command);
+	#define probe_pclose(fp) fclose(fp)
+#else // _WIN32
+	#define probe_popen(command) popen(command, "r")
+	#define probe_pclose(fp) pclose(fp)
+#endif // _WIN32
+void print_ascii(struct info *user_info);
+void print_image(struct info *user_info);
+void uwu_kernel(struct strbuf *buf, const char *text);
+void uwu_hw(char *hwname, size_t size);
+void uwu_name(struct configuration *config_flags, struct info *user_info);
+const char *uwu_lookup(const char *name, size_t len);
+void truncate_name(char *name, int target_width);
+void remove_brackets(char *str);
+void add_gpu(struct info *user_info, char *gpu, size_t size);
+#ifdef __linux__
+int read_sysfs_line(const char *dir, const char *attribute, char *value,
+					size_t size);
+int read_drm_screens(struct info *user_info);
+#endif // __linux__
+#ifndef _WIN32
+int query_x11_screens(struct info *user_info);
+int read_x11_screens(struct info *user_info);
+#endif // _WIN32
+#ifdef __linux__
+int read_cpu_topology(struct cpu_topology *topology);
+#endif // __linux__
+#if defined(__x86_64__) || defined(__i386__)
+int read_cpuid_brand(char *model, size_t size);
+#endif // defined(__x86_64__) || defined(__i386__)
+#ifndef _WIN32
+int read_cpuinfo(const char *key, char *value, size_t size);
+#endif // _WIN32
+int read_cpu_model(struct info *user_info, char *model, size_t size);
+
+#endif // FETCH_H
@@ -0,0 +1,96 @@
+/*
+ *  UwUfetch is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ libuwufetch: the collectors, the uwuifier and the renderer of uwufetch, for
+programs that fetch the info over and over, like a status bar. The info
+keeps its strings between the calls and the slow lookups (the pci.ids index,
+the uname, the uwufied names) are only done once per process, so a refresh
+costs only the probes of the fields asked for.
+
+    struct uwu_info *info = uwu_info_new();
+    uwu_collect(UWU_FIELD_CPU | UWU_FIELD_RAM, info);
+    char text[256];
+    uwu_render(info, UWU_FORMAT_KV, text, sizeof(text));
+    uwu_info_free(info);
+
+Link with -luwufetch -pthread, and -ldl on Linux. The names and values below
+only change together with UWU_API_VERSION.
+*/
+#ifndef UWUFETCH_H
+#define UWUFETCH_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UWU_API_VERSION 1
+
+#if defined(__GNUC__) && !defined(_WIN32)
+	#define UWU_API __attribute__((visibility("default")))
+#else
+	#define UWU_API
+#endif
+
+// the fields of uwu_collect(), the os is always collected with the others
+#define UWU_FIELD_OS (1 << 0)
+#define UWU_FIELD_USER (1 << 1) // user, host and shell
+#define UWU_FIELD_HOST (1 << 2)
+#define UWU_FIELD_CPU (1 << 3)
+#define UWU_FIELD_KERNEL (1 << 4)
+#define UWU_FIELD_RAM (1 << 5) // with the swap, buffers and hugepages
+#define UWU_FIELD_GPU (1 << 6)
+#define UWU_FIELD_RESOLUTION (1 << 7)
+#define UWU_FIELD_PKGS (1 << 8)
+#define UWU_FIELD_ALL ((1 << 9) - 1)
+
+// the formats of uwu_render(), the ones of uwufetch --format
+#define UWU_FORMAT_ART 0 // the logo and the info, as printed in a terminal
+#define UWU_FORMAT_JSON 1
+#define UWU_FORMAT_KV 2
+#define UWU_FORMAT_ENV 3
+
+struct uwu_info; // only used through the functions below
+
+// returns NULL if the memory could not be allocated
+UWU_API struct uwu_info *uwu_info_new(void);
+
+/*
+ Collects the given fields again, the others keep their last values, and
+every field collected so far is rendered. The probes run in parallel and the
+call takes at most a few seconds, like a run of uwufetch. Calls from other
+threads wait for the running one, even with different infos, since the probes
+share their deadline. The environment of the process is not changed, the
+commands run by the probes get LANG=en_US so that they print in english.
+*/
+UWU_API void uwu_collect(int fields, struct uwu_info *info);
+
+/*
+ Renders the info in a format, as a nul terminated string of at most len
+bytes. It can run from any thread, also while other threads render the same
+info. Returns the length of the text, -1 if it had to be cut.
+*/
+UWU_API int uwu_render(struct uwu_info *info, int format, char *buf,
+					   size_t len);
+
+UWU_API void uwu_info_free(struct uwu_info *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UWUFETCH_H